@@ -0,0 +1,235 @@
+#include "CppUnitTest.h"
+
+#include "red_black_tree.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace red_black_tree_tests
+{
+	typedef red_black_tree<int, std::less<int>, order_statistics> order_statistics_tree;
+	typedef order_statistics_tree::node_type order_statistics_node;
+
+	struct sum {
+
+		using value_type = long long;
+
+		static value_type identity() { return 0; }
+		static value_type lift(const int& data) { return data; }
+		static value_type combine(const value_type& a, const value_type& b) { return a + b; }
+
+	};
+
+	typedef red_black_tree<int, std::less<int>, aggregate<sum>> sum_tree;
+	typedef sum_tree::node_type sum_node;
+
+	// Concatenates the payloads, counting the aggregates alive to catch any that are never destructed
+	struct concatenation {
+
+		struct value_type {
+
+			static int alive;
+
+			std::string text;
+
+			value_type() { ++alive; }
+			value_type(std::string text) : text(std::move(text)) { ++alive; }
+			value_type(const value_type& other) : text(other.text) { ++alive; }
+			~value_type() { --alive; }
+
+			value_type& operator=(const value_type& other) = default;
+
+		};
+
+		static value_type identity() { return value_type(); }
+		static value_type lift(const int& data) { return value_type(std::to_string(data)); }
+		static value_type combine(const value_type& a, const value_type& b) { return value_type(a.text + b.text); }
+
+	};
+
+	int concatenation::value_type::alive = 0;
+
+	typedef red_black_tree<int, std::less<int>, aggregate<concatenation>> concatenation_tree;
+
+	TEST_CLASS(test_augmentation)
+	{
+	public:
+
+		TEST_METHOD(test_order_statistics_update)
+		{
+			order_statistics_node a(0);
+			order_statistics_node b(2);
+			order_statistics_node n(1);
+
+			n.left = &a;
+			n.right = &b;
+
+			// Recompute n from its children
+			order_statistics::update(n);
+
+			Assert::IsTrue(a.subtree_size == 1);
+			Assert::IsTrue(b.subtree_size == 1);
+			Assert::IsTrue(n.subtree_size == 3);
+		}
+
+		TEST_METHOD(test_order_statistics_rotate)
+		{
+			// Create tree //
+
+			//	   \ /
+			//		n
+			//	   / \
+			//	  a	  y
+			//		 / \
+			//		b	c
+
+			order_statistics_tree tree;
+
+			for (const auto value : { 1, 0, 3, 2, 4 }) {
+				insert(value, tree);
+			}
+
+			const auto n = static_cast<order_statistics_node*>(tree.root);
+			const auto y = static_cast<order_statistics_node*>(tree.root->right);
+
+
+			// Rotate //
+
+			utils::rotate_left<int>(tree, tree.root);
+
+
+			// Assert //
+
+			//	   \ /
+			//		y
+			//	   / \
+			//	  n	  c
+			//	 / \
+			//	a	b
+
+			Assert::IsTrue(tree.root == y);
+			Assert::IsTrue(y->subtree_size == 5);
+			Assert::IsTrue(n->subtree_size == 3);
+		}
+
+		TEST_METHOD(test_order_statistics_remove)
+		{
+			order_statistics_tree tree;
+
+			for (auto value = 0; value < 10; ++value) {
+				insert(value, tree);
+			}
+
+			remove<int>(3, tree);
+			remove<int>(7, tree);
+
+			Assert::IsTrue(static_cast<order_statistics_node*>(tree.root)->subtree_size == 8);
+		}
+
+		TEST_METHOD(test_aggregate_update)
+		{
+			sum_node a(1);
+			sum_node b(3);
+			sum_node n(2);
+
+			n.left = &a;
+			n.right = &b;
+
+			// Recompute the children, then n
+			aggregate<sum>::update(a);
+			aggregate<sum>::update(b);
+			aggregate<sum>::update(n);
+
+			Assert::IsTrue(a.subtree_aggregate == 1);
+			Assert::IsTrue(b.subtree_aggregate == 3);
+			Assert::IsTrue(n.subtree_aggregate == 6);
+		}
+
+		TEST_METHOD(test_aggregate_maintained)
+		{
+			sum_tree tree;
+
+			for (auto value = 1; value <= 10; ++value) {
+				insert(value, tree);
+			}
+
+			Assert::IsTrue(static_cast<sum_node*>(tree.root)->subtree_aggregate == 55);
+
+			remove<int>(4, tree);
+			remove<int>(10, tree);
+
+			Assert::IsTrue(static_cast<sum_node*>(tree.root)->subtree_aggregate == 41);
+		}
+
+		TEST_METHOD(test_combined_augmentations)
+		{
+			red_black_tree<int, std::less<int>, augmentations<order_statistics, aggregate<sum>>> tree;
+
+			for (auto value = 1; value <= 10; ++value) {
+				insert(value, tree);
+			}
+
+			Assert::IsTrue(*select(2, tree) == 3);
+			Assert::IsTrue(rank(5, tree) == 4);
+			Assert::IsTrue(aggregate_range(3, 6, tree) == 12);
+		}
+
+		TEST_METHOD(test_multiset_counts_copies)
+		{
+			red_black_tree<int, std::less<int>, augmentations<aggregate<sum>, multiplicity>> tree;
+
+			for (auto value = 1; value <= 10; ++value) {
+				insert(value, tree);
+			}
+
+			for (auto copy = 0; copy < 5; ++copy) {
+				insert(4, tree);
+			}
+
+			// Assert iteration visits every copy, both ways
+			Assert::IsTrue(std::distance(tree.begin(), tree.end()) == 15);
+			Assert::IsTrue(std::distance(tree.rbegin(), tree.rend()) == 15);
+			Assert::IsTrue(std::count(tree.begin(), tree.end(), 4) == 6);
+
+			// Assert the aggregates fold every copy and follow the counts
+			Assert::IsTrue(aggregate_range(3, 6, tree) == 32);
+			Assert::IsTrue(static_cast<decltype(tree)::node_type*>(tree.root)->subtree_aggregate == 75);
+
+			remove(4, tree);
+
+			Assert::IsTrue(aggregate_range(0, 100, tree) == 71);
+		}
+
+				TEST_METHOD(test_non_trivial_metadata_destructed)
+		{
+			// Trivial nodes may still be released in bulk
+			Assert::IsTrue(std::is_trivially_destructible<red_black_tree<int>::node_type>::value);
+			Assert::IsTrue(!std::is_trivially_destructible<concatenation_tree::node_type>::value);
+
+			{
+				concatenation_tree tree;
+
+				for (auto value = 0; value < 100; ++value) {
+					insert(value, tree);
+				}
+
+				clear(tree);
+
+				// Assert clearing destructed the metadata of every node
+				Assert::IsTrue(concatenation::value_type::alive == 0);
+
+				for (auto value = 0; value < 100; ++value) {
+					insert(value, tree);
+				}
+			}
+
+			// Assert so did the destructor
+			Assert::IsTrue(concatenation::value_type::alive == 0);
+		}
+
+	};
+}
\ No newline at end of file
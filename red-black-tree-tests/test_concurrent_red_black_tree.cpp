@@ -0,0 +1,138 @@
+#include "CppUnitTest.h"
+
+#include "concurrent_red_black_tree.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace red_black_tree_tests
+{
+	TEST_CLASS(test_concurrent_red_black_tree)
+	{
+	public:
+
+		TEST_METHOD(test_insert_find_remove)
+		{
+			concurrent_red_black_tree<int> tree;
+
+			for (auto value = 0; value < 100; ++value) {
+				insert(value, tree);
+			}
+
+			Assert::IsTrue(size(tree) == 100);
+			Assert::IsTrue(find(42, tree));
+			Assert::IsTrue(*lookup(42, tree) == 42);
+
+			Assert::IsTrue(remove(42, tree));
+			Assert::IsTrue(!remove(42, tree));
+
+			Assert::IsTrue(!find(42, tree));
+			Assert::IsTrue(!lookup(42, tree).has_value());
+			Assert::IsTrue(size(tree) == 99);
+		}
+
+		TEST_METHOD(test_duplicate_releases_writer)
+		{
+			concurrent_red_black_tree<int> tree;
+
+			insert(1, tree);
+
+			auto threw = false;
+
+			try {
+				insert(1, tree);
+			}
+
+			catch (const std::runtime_error&) {
+				threw = true;
+			}
+
+			// Assert the failed write left the tree readable and writable
+			Assert::IsTrue(threw);
+			Assert::IsTrue(tree.version % 2 == 0);
+
+			insert(2, tree);
+
+			Assert::IsTrue(find(2, tree));
+		}
+
+		TEST_METHOD(test_removed_nodes_are_recycled)
+		{
+			concurrent_red_black_tree<int> tree;
+
+			for (auto round = 0; round < 10; ++round) {
+
+				for (auto value = 0; value < 100; ++value) {
+					insert(value, tree);
+				}
+
+				for (auto value = 0; value < 100; ++value) {
+					remove(value, tree);
+				}
+
+			}
+
+			// Assert the retired nodes do not pile up without readers around
+			Assert::IsTrue(tree.retired.size() <= utils::reclaim_threshold);
+		}
+
+		TEST_METHOD(test_readers_alongside_writer)
+		{
+			concurrent_red_black_tree<int> tree;
+
+			// Even payloads stay for good, odd ones come and go
+			for (auto value = 0; value < 2000; value += 2) {
+				insert(value, tree);
+			}
+
+			std::atomic<bool> done(false);
+			std::atomic<int> misses(0);
+
+			std::vector<std::thread> readers;
+
+			for (auto reader = 0; reader < 4; ++reader) {
+
+				readers.emplace_back([&]() {
+
+					while (!done) {
+
+						for (auto value = 0; value < 2000; value += 2) {
+
+							if (!find(value, tree)) ++misses;
+
+						}
+
+					}
+
+				});
+
+			}
+
+			for (auto round = 0; round < 20; ++round) {
+
+				for (auto value = 1; value < 2000; value += 2) {
+					insert(value, tree);
+				}
+
+				for (auto value = 1; value < 2000; value += 2) {
+					remove(value, tree);
+				}
+
+			}
+
+			done = true;
+
+			for (auto& reader : readers) {
+				reader.join();
+			}
+
+			// Assert no reader ever missed a stable payload
+			Assert::IsTrue(misses == 0);
+			Assert::IsTrue(size(tree) == 1000);
+		}
+
+	};
+}
\ No newline at end of file
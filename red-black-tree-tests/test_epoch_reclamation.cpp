@@ -0,0 +1,49 @@
+#include "CppUnitTest.h"
+
+#include "epoch_reclamation.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace red_black_tree_tests
+{
+	TEST_CLASS(test_epoch_reclamation)
+	{
+	public:
+
+		TEST_METHOD(test_advance_without_readers)
+		{
+			epoch_domain domain;
+
+			const auto retired = domain.global_epoch.load();
+
+			Assert::IsTrue(domain.try_advance());
+			Assert::IsTrue(!domain.is_safe(retired));
+
+			Assert::IsTrue(domain.try_advance());
+			Assert::IsTrue(domain.is_safe(retired));
+		}
+
+		TEST_METHOD(test_reader_holds_epoch)
+		{
+			epoch_domain domain;
+
+			const auto retired = domain.global_epoch.load();
+
+			{
+				epoch_guard guard(domain);
+
+				// Assert a reader of the retire epoch keeps it from becoming safe
+				domain.try_advance();
+				domain.try_advance();
+				domain.try_advance();
+
+				Assert::IsTrue(!domain.is_safe(retired));
+			}
+
+			domain.try_advance();
+
+			Assert::IsTrue(domain.is_safe(retired));
+		}
+
+	};
+}
\ No newline at end of file
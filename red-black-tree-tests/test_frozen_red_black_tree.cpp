@@ -0,0 +1,121 @@
+#include "CppUnitTest.h"
+
+#include "frozen_red_black_tree.h"
+#include "red_black_tree.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace red_black_tree_tests
+{
+	TEST_CLASS(test_frozen_red_black_tree)
+	{
+	public:
+
+		TEST_METHOD(test_layout)
+		{
+			red_black_tree<int> tree;
+
+			for (auto value = 0; value < 7; ++value) {
+				insert(value, tree);
+			}
+
+			const auto frozen = freeze(tree);
+
+			// Assert the levels are stored one after the other
+			const std::vector<int> expected_result = { 3, 1, 5, 0, 2, 4, 6 };
+
+			Assert::IsTrue(std::equal(frozen.elements.begin(), frozen.elements.end(), expected_result.begin(), expected_result.end()));
+			Assert::IsTrue(size(frozen) == 7);
+
+			// Assert the root sits one element past a cache line boundary
+			const auto address = reinterpret_cast<std::uintptr_t>(frozen.elements.data());
+
+			Assert::IsTrue((address - sizeof(int)) % utils::cache_line_bytes == 0);
+		}
+
+		TEST_METHOD(test_empty)
+		{
+			red_black_tree<int> tree;
+
+			const auto frozen = freeze(tree);
+
+			Assert::IsTrue(size(frozen) == 0);
+			Assert::IsTrue(!find(1, frozen));
+			Assert::IsTrue(lower_bound(1, frozen) == nullptr);
+		}
+
+		TEST_METHOD(test_lower_bound)
+		{
+			// Cover complete and incomplete last levels alike
+			for (auto count = 1; count < 100; ++count) {
+
+				red_black_tree<int> tree;
+				std::vector<int> sorted = {};
+
+				for (auto value = 0; value < count; ++value) {
+
+					insert(2 * value, tree);
+					sorted.push_back(2 * value);
+
+				}
+
+				const auto frozen = freeze(tree);
+
+				for (auto key = -1; key <= 2 * count; ++key) {
+
+					const auto expected = std::lower_bound(sorted.begin(), sorted.end(), key);
+					const auto result = lower_bound(key, frozen);
+
+					Assert::IsTrue(expected == sorted.end() ? result == nullptr : result && *result == *expected);
+					Assert::IsTrue(find(key, frozen) == (key >= 0 && key % 2 == 0 && key < 2 * count));
+
+				}
+
+			}
+		}
+
+		TEST_METHOD(test_count_trailing_ones)
+		{
+			Assert::IsTrue(utils::count_trailing_ones(0) == 0);
+			Assert::IsTrue(utils::count_trailing_ones(6) == 0);
+			Assert::IsTrue(utils::count_trailing_ones(7) == 3);
+			Assert::IsTrue(utils::count_trailing_ones(0x2F) == 4);
+		}
+
+		TEST_METHOD(test_transparent_key)
+		{
+			red_black_tree<std::string, std::less<>> tree;
+
+			insert(std::string("apple"), tree);
+			insert(std::string("cherry"), tree);
+
+			const auto frozen = freeze(tree);
+
+			Assert::IsTrue(find("cherry", frozen));
+			Assert::IsTrue(!find("banana", frozen));
+			Assert::IsTrue(*lower_bound("banana", frozen) == "cherry");
+		}
+
+		TEST_METHOD(test_independent_of_tree)
+		{
+			red_black_tree<int> tree;
+
+			insert(1, tree);
+
+			const auto frozen = freeze(tree);
+
+			insert(2, tree);
+			remove(1, tree);
+
+			// Assert the snapshot kept its payloads
+			Assert::IsTrue(find(1, frozen));
+			Assert::IsTrue(!find(2, frozen));
+		}
+
+	};
+}
\ No newline at end of file
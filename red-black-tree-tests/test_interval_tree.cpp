@@ -0,0 +1,91 @@
+#include "CppUnitTest.h"
+
+#include "interval_tree.h"
+
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace red_black_tree_tests
+{
+	typedef interval_tree<int>::node_type interval_node;
+
+	TEST_CLASS(test_interval_tree)
+	{
+	public:
+
+		interval_tree<int> tree;
+
+		test_interval_tree()
+		{
+			insert(interval<int>{ 15, 20 }, this->tree);
+			insert(interval<int>{ 10, 30 }, this->tree);
+			insert(interval<int>{ 17, 19 }, this->tree);
+			insert(interval<int>{ 5, 20 }, this->tree);
+			insert(interval<int>{ 12, 15 }, this->tree);
+			insert(interval<int>{ 30, 40 }, this->tree);
+			insert(interval<int>{ 1, 3 }, this->tree);
+		}
+
+		TEST_METHOD(test_max_endpoint)
+		{
+			Assert::IsTrue(static_cast<interval_node*>(this->tree.root)->subtree_aggregate == 40);
+
+			remove(interval<int>{ 30, 40 }, this->tree);
+
+			Assert::IsTrue(static_cast<interval_node*>(this->tree.root)->subtree_aggregate == 30);
+		}
+
+		TEST_METHOD(test_for_each_overlapping)
+		{
+			const std::vector<interval<int>> expected_result = { { 5, 20 }, { 10, 30 }, { 12, 15 } };
+
+			std::vector<interval<int>> result = {};
+
+			for_each_overlapping(13, 14, this->tree, [&result](const auto& data) {
+				result.push_back(data);
+			});
+
+			Assert::IsTrue(result == expected_result);
+		}
+
+		TEST_METHOD(test_for_each_overlapping_touching)
+		{
+			const std::vector<interval<int>> expected_result = { { 10, 30 }, { 30, 40 } };
+
+			std::vector<interval<int>> result = {};
+
+			// Closed intervals sharing an endpoint overlap
+			for_each_overlapping(30, 35, this->tree, [&result](const auto& data) {
+				result.push_back(data);
+			});
+
+			Assert::IsTrue(result == expected_result);
+		}
+
+		TEST_METHOD(test_for_each_containing)
+		{
+			const std::vector<interval<int>> expected_result = { { 5, 20 }, { 10, 30 }, { 15, 20 }, { 17, 19 } };
+
+			std::vector<interval<int>> result = {};
+
+			for_each_containing(18, this->tree, [&result](const auto& data) {
+				result.push_back(data);
+			});
+
+			Assert::IsTrue(result == expected_result);
+		}
+
+		TEST_METHOD(test_no_overlap)
+		{
+			auto visited = 0;
+
+			for_each_overlapping(41, 50, this->tree, [&visited](const auto&) {
+				++visited;
+			});
+
+			Assert::IsTrue(visited == 0);
+		}
+
+	};
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "CppUnitTest.h"
+
+#include "node_handle.h"
+#include "node_pool.h"
+#include "red_black_node.h"
+
+#include <memory>
+#include <utility>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace red_black_tree_tests
+{
+	typedef red_black_node<int> node;
+
+	TEST_CLASS(test_node_handle)
+	{
+	public:
+
+		TEST_METHOD(test_default_constructor)
+		{
+			node_handle<int, node> handle;
+
+			Assert::IsTrue(handle.empty());
+			Assert::IsTrue(!handle);
+		}
+
+		TEST_METHOD(test_destructor_releases_node)
+		{
+			const auto pool = std::make_shared<node_pool<node>>();
+
+			const auto allocated = pool->allocate(691);
+
+			{
+				node_handle<int, node> handle(pool, allocated);
+
+				Assert::IsTrue(handle.value() == 691);
+			}
+
+			// Assert the dropped node's slot is handed out again
+			Assert::IsTrue(pool->allocate(7) == allocated);
+		}
+
+		TEST_METHOD(test_move)
+		{
+			const auto pool = std::make_shared<node_pool<node>>();
+
+			const auto allocated = pool->allocate(691);
+
+			node_handle<int, node> handle(pool, allocated);
+			node_handle<int, node> other(std::move(handle));
+
+			Assert::IsTrue(handle.empty());
+			Assert::IsTrue(other.node == allocated);
+
+			handle = std::move(other);
+
+			Assert::IsTrue(other.empty());
+			Assert::IsTrue(handle.node == allocated);
+
+			// Assert release gives up ownership
+			Assert::IsTrue(handle.release() == allocated);
+			Assert::IsTrue(handle.empty());
+
+			pool->deallocate(allocated);
+		}
+
+	};
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "CppUnitTest.h"
+
+#include "node_pool.h"
+#include "red_black_node.h"
+
+#include <memory>
+#include <set>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace red_black_tree_tests
+{
+	typedef red_black_node<int> node;
+
+	TEST_CLASS(test_node_pool)
+	{
+	public:
+
+		TEST_METHOD(test_allocate)
+		{
+			node_pool<node> pool;
+
+			// Allocate a node
+			const auto allocated = pool.allocate(691);
+
+			Assert::IsTrue(allocated != nullptr);
+			Assert::IsTrue(allocated->data == 691);
+			Assert::IsTrue(allocated->left == nullptr);
+			Assert::IsTrue(allocated->right == nullptr);
+		}
+
+		TEST_METHOD(test_deallocate_recycles_node)
+		{
+			node_pool<node> pool;
+
+			const auto first = pool.allocate(691);
+			pool.allocate(83);
+
+			// Release the first node and allocate again
+			pool.deallocate(first);
+			const auto recycled = pool.allocate(7);
+
+			// Assert the released slot is handed out again
+			Assert::IsTrue(recycled == first);
+			Assert::IsTrue(recycled->data == 7);
+		}
+
+		TEST_METHOD(test_allocate_across_chunks)
+		{
+			node_pool<node> pool;
+
+			const auto count = node_pool<node>::chunk_capacity * 2 + 1;
+
+			std::set<node*> nodes = {};
+
+			for (std::size_t i = 0; i < count; ++i) {
+				nodes.insert(pool.allocate(static_cast<int>(i)));
+			}
+
+			// Assert every allocation received its own slot
+			Assert::IsTrue(nodes.size() == count);
+		}
+
+		TEST_METHOD(test_merge)
+		{
+			auto target = std::make_shared<node_pool<node>>();
+			auto source = std::make_shared<node_pool<node>>();
+
+			const auto kept = source->allocate(691);
+			const auto released = source->allocate(83);
+			source->deallocate(released);
+
+			node_pool<node>::merge(target, source);
+
+			// Release through source and drop it, its memory now belongs to target
+			source->deallocate(kept);
+			source.reset();
+
+			std::set<node*> nodes = {};
+
+			for (std::size_t i = 0; i < node_pool<node>::chunk_capacity; ++i) {
+				nodes.insert(target->allocate(static_cast<int>(i)));
+			}
+
+			// Assert the slots of source are handed out by target
+			Assert::IsTrue(nodes.count(kept) == 1);
+			Assert::IsTrue(nodes.count(released) == 1);
+		}
+
+		TEST_METHOD(test_merge_spare_chunks)
+		{
+			auto target = std::make_shared<node_pool<node>>();
+			auto source = std::make_shared<node_pool<node>>();
+
+			const auto count = node_pool<node>::chunk_capacity;
+
+			std::set<node*> nodes = {};
+
+			for (std::size_t i = 0; i < count; ++i) {
+				nodes.insert(source->allocate(static_cast<int>(i)));
+			}
+
+			// Leave source with a spare chunk only, then hand it over
+			source->reset();
+			node_pool<node>::merge(target, source);
+
+			// Assert target hands out the spare chunk of source
+			for (std::size_t i = 0; i < count; ++i) {
+				Assert::IsTrue(nodes.count(target->allocate(static_cast<int>(i))) == 1);
+			}
+		}
+
+		TEST_METHOD(test_merge_compresses_chain)
+		{
+			auto first = std::make_shared<node_pool<node>>();
+			auto second = std::make_shared<node_pool<node>>();
+			auto third = std::make_shared<node_pool<node>>();
+
+			// Chain first to second to third
+			node_pool<node>::merge(second, first);
+			node_pool<node>::merge(third, second);
+
+			// Assert resolving the head of the chain points it straight at the owner
+			Assert::IsTrue(first->resolve() == third.get());
+			Assert::IsTrue(first->successor == third);
+
+			// Merging pools that already share an owner changes nothing
+			node_pool<node>::merge(first, second);
+
+			Assert::IsTrue(third->successor == nullptr);
+		}
+
+		TEST_METHOD(test_merge_drops_chain)
+		{
+			auto first = std::make_shared<node_pool<node>>();
+			auto second = std::make_shared<node_pool<node>>();
+			auto third = std::make_shared<node_pool<node>>();
+
+			node_pool<node>::merge(second, first);
+			node_pool<node>::merge(third, second);
+
+			// Leave the chain as the only owner of the pool in its middle
+			second.reset();
+
+			// Assert resolving releases that pool safely and still reaches the owner
+			Assert::IsTrue(first->resolve() == third.get());
+			Assert::IsTrue(first->successor == third);
+		}
+
+		TEST_METHOD(test_reset_keeps_chunks)
+		{
+			node_pool<node> pool;
+
+			// Fill two chunks completely
+			const auto count = node_pool<node>::chunk_capacity * 2;
+
+			std::set<node*> nodes = {};
+
+			for (std::size_t i = 0; i < count; ++i) {
+				nodes.insert(pool.allocate(static_cast<int>(i)));
+			}
+
+			// Take every slot back without deallocating the nodes one by one
+			pool.reset();
+
+			// Assert the allocations after the reset reuse the same slots
+			for (std::size_t i = 0; i < count; ++i) {
+				Assert::IsTrue(nodes.count(pool.allocate(static_cast<int>(i))) == 1);
+			}
+		}
+
+	};
+}
@@ -0,0 +1,75 @@
+#include "CppUnitTest.h"
+
+#include "persistent_red_black_tree.h"
+
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace red_black_tree_tests
+{
+	TEST_CLASS(test_persistent_red_black_tree)
+	{
+	public:
+
+		TEST_METHOD(test_insert_find_remove)
+		{
+			persistent_red_black_tree<int> tree;
+
+			for (const auto value : { 9, 1, 2, 7, 6, 3, 0, 5, 4, 8 }) {
+				insert(value, tree);
+			}
+
+			// Assert the root is black and the payloads are in order
+			Assert::IsTrue(tree.root->node_color == color::black);
+			Assert::IsTrue(std::vector<int>(tree.begin(), tree.end()) == std::vector<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+
+			Assert::IsTrue(remove(5, tree));
+			Assert::IsTrue(!remove(5, tree));
+
+			Assert::IsTrue(!find(5, tree));
+			Assert::IsTrue(find(4, tree));
+			Assert::IsTrue(size(tree) == 9);
+		}
+
+		TEST_METHOD(test_snapshot)
+		{
+			persistent_red_black_tree<int> tree;
+
+			for (auto value = 0; value < 10; ++value) {
+				insert(value, tree);
+			}
+
+			const auto snapshot = tree;
+
+			remove(3, tree);
+			insert(10, tree);
+
+			// Assert the snapshot kept its version
+			Assert::IsTrue(find(3, snapshot));
+			Assert::IsTrue(!find(10, snapshot));
+			Assert::IsTrue(size(snapshot) == 10);
+
+			Assert::IsTrue(!find(3, tree));
+			Assert::IsTrue(find(10, tree));
+		}
+
+		TEST_METHOD(test_path_copying)
+		{
+			persistent_red_black_tree<int> tree;
+
+			for (auto value = 0; value < 100; ++value) {
+				insert(value, tree);
+			}
+
+			const auto snapshot = tree;
+
+			insert(100, tree);
+
+			// Assert the subtree off the search path is shared, not copied
+			Assert::IsTrue(tree.root != snapshot.root);
+			Assert::IsTrue(tree.root->left == snapshot.root->left);
+		}
+
+	};
+}
\ No newline at end of file
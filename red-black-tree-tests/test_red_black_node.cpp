@@ -16,10 +16,10 @@ namespace red_black_tree_tests
 			const red_black_node<int> node(691);
 
 			Assert::IsTrue(node.data == 691);
-			Assert::IsTrue(node.color == color::black);
+			Assert::IsTrue(node.get_color() == color::black);
 			Assert::IsTrue(node.left == nullptr);
 			Assert::IsTrue(node.right == nullptr);
-			Assert::IsTrue(node.parent == nullptr);
+			Assert::IsTrue(node.get_parent() == nullptr);
 		}
 
 		TEST_METHOD(test_copy_constructor)
@@ -27,8 +27,8 @@ namespace red_black_tree_tests
 			red_black_node<int> node(691);
 			node.left = &node;
 			node.right = &node;
-			node.parent = &node;
-			node.color = color::red;
+			node.set_parent(&node);
+			node.set_color(color::red);
 
 			// Call the copy constructor
 			const auto node_copy = node;
@@ -37,15 +37,15 @@ namespace red_black_tree_tests
 			Assert::IsTrue(node.data == 691);
 			Assert::IsTrue(node.left == &node);
 			Assert::IsTrue(node.right == &node);
-			Assert::IsTrue(node.parent == &node);
-			Assert::IsTrue(node.color == color::red);
+			Assert::IsTrue(node.get_parent() == &node);
+			Assert::IsTrue(node.get_color() == color::red);
 
 			// Assert node_copy == node
 			Assert::IsTrue(node_copy.data == node.data);
 			Assert::IsTrue(node_copy.left == &node);
 			Assert::IsTrue(node_copy.right == &node);
-			Assert::IsTrue(node_copy.parent == &node);
-			Assert::IsTrue(node_copy.color == color::red);
+			Assert::IsTrue(node_copy.get_parent() == &node);
+			Assert::IsTrue(node_copy.get_color() == color::red);
 		}
 
 		TEST_METHOD(test_move_constructor)
@@ -53,8 +53,8 @@ namespace red_black_tree_tests
 			red_black_node<int> node(691);
 			node.left = &node;
 			node.right = &node;
-			node.parent = &node;
-			node.color = color::red;
+			node.set_parent(&node);
+			node.set_color(color::red);
 
 			// Call the copy constructor
 			const auto node_copy = std::move(node);
@@ -63,15 +63,15 @@ namespace red_black_tree_tests
 			Assert::IsTrue(node.data == 691);
 			Assert::IsTrue(node.left == nullptr);
 			Assert::IsTrue(node.right == nullptr);
-			Assert::IsTrue(node.parent == nullptr);
-			Assert::IsTrue(node.color == color::black);
+			Assert::IsTrue(node.get_parent() == nullptr);
+			Assert::IsTrue(node.get_color() == color::black);
 
 			// Assert node_copy == node
 			Assert::IsTrue(node_copy.data == 691);
 			Assert::IsTrue(node_copy.left == &node);
 			Assert::IsTrue(node_copy.right == &node);
-			Assert::IsTrue(node_copy.parent == &node);
-			Assert::IsTrue(node_copy.color == color::red);
+			Assert::IsTrue(node_copy.get_parent() == &node);
+			Assert::IsTrue(node_copy.get_color() == color::red);
 		}
 
 		TEST_METHOD(test_copy_assignment)
@@ -79,8 +79,8 @@ namespace red_black_tree_tests
 			red_black_node<int> node_0(691);
 			node_0.left = &node_0;
 			node_0.right = &node_0;
-			node_0.parent = &node_0;
-			node_0.color = color::red;
+			node_0.set_parent(&node_0);
+			node_0.set_color(color::red);
 
 			red_black_node<int> node_1(83);
 
@@ -91,15 +91,15 @@ namespace red_black_tree_tests
 			Assert::IsTrue(node_0.data == 691);
 			Assert::IsTrue(node_0.left == &node_0);
 			Assert::IsTrue(node_0.right == &node_0);
-			Assert::IsTrue(node_0.parent == &node_0);
-			Assert::IsTrue(node_0.color == color::red);
+			Assert::IsTrue(node_0.get_parent() == &node_0);
+			Assert::IsTrue(node_0.get_color() == color::red);
 
 			// Assert node_1 now has all values from node_0
 			Assert::IsTrue(node_1.data == 691);
 			Assert::IsTrue(node_1.left == &node_0);
 			Assert::IsTrue(node_1.right == &node_0);
-			Assert::IsTrue(node_1.parent == &node_0);
-			Assert::IsTrue(node_1.color == color::red);
+			Assert::IsTrue(node_1.get_parent() == &node_0);
+			Assert::IsTrue(node_1.get_color() == color::red);
 		}
 
 		TEST_METHOD(test_move_assignment)
@@ -107,8 +107,8 @@ namespace red_black_tree_tests
 			red_black_node<int> node_0(691);
 			node_0.left = &node_0;
 			node_0.right = &node_0;
-			node_0.parent = &node_0;
-			node_0.color = color::red;
+			node_0.set_parent(&node_0);
+			node_0.set_color(color::red);
 
 			red_black_node<int> node_1(83);
 
@@ -119,15 +119,44 @@ namespace red_black_tree_tests
 			Assert::IsTrue(node_0.data == 691);
 			Assert::IsTrue(node_0.left == nullptr);
 			Assert::IsTrue(node_0.right == nullptr);
-			Assert::IsTrue(node_0.parent == nullptr);
-			Assert::IsTrue(node_0.color == color::black);
+			Assert::IsTrue(node_0.get_parent() == nullptr);
+			Assert::IsTrue(node_0.get_color() == color::black);
 
 			// Assert node_1 now has all values from node_0
 			Assert::IsTrue(node_1.data == 691);
 			Assert::IsTrue(node_1.left == &node_0);
 			Assert::IsTrue(node_1.right == &node_0);
-			Assert::IsTrue(node_1.parent == &node_0);
-			Assert::IsTrue(node_1.color == color::red);
+			Assert::IsTrue(node_1.get_parent() == &node_0);
+			Assert::IsTrue(node_1.get_color() == color::red);
+		}
+
+		TEST_METHOD(test_color_does_not_disturb_parent)
+		{
+			red_black_node<int> parent(83);
+			red_black_node<int> node(691);
+
+			node.set_parent(&parent);
+			node.set_color(color::red);
+
+			Assert::IsTrue(node.get_parent() == &parent);
+			Assert::IsTrue(node.get_color() == color::red);
+
+			node.set_parent(nullptr);
+
+			Assert::IsTrue(node.get_parent() == nullptr);
+			Assert::IsTrue(node.get_color() == color::red);
+
+			node.set_color(color::black);
+			node.set_parent(&parent);
+
+			Assert::IsTrue(node.get_parent() == &parent);
+			Assert::IsTrue(node.get_color() == color::black);
+		}
+
+		TEST_METHOD(test_compact_layout)
+		{
+			// An int node holds its payload and three pointers, with no vtable and no separate color
+			Assert::IsTrue(sizeof(red_black_node<int>) <= 4 * sizeof(void*));
 		}
 
 	};
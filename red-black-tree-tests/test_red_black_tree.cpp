@@ -3,6 +3,12 @@
 #include "red_black_tree.h"
 #include "traversal.h"
 
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <string>
+#include <string_view>
+
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 namespace red_black_tree_tests
@@ -24,27 +30,28 @@ namespace red_black_tree_tests
 			//		 / \
 			//		b	c
 
-			auto a = new node(0);
-			auto b = new node(0);
-			auto c = new node(0);
+			red_black_tree<int> tree;
+
+			auto a = tree.pool->allocate(0);
+			auto b = tree.pool->allocate(0);
+			auto c = tree.pool->allocate(0);
 
-			auto y = new node(0);
+			auto y = tree.pool->allocate(0);
 
 			y->left = b;
-			b->parent = y;
+			b->set_parent(y);
 
 			y->right = c;
-			c->parent = y;
+			c->set_parent(y);
 
-			auto n = new node(0);
+			auto n = tree.pool->allocate(0);
 
 			n->left = a;
-			a->parent = n;
+			a->set_parent(n);
 
 			n->right = y;
-			y->parent = n;
+			y->set_parent(n);
 
-			red_black_tree<int> tree;
 			tree.root = n;
 
 
@@ -64,27 +71,27 @@ namespace red_black_tree_tests
 
 			// Assert y's peers
 			Assert::IsTrue(tree.root == y);
-			Assert::IsTrue(y->parent == nullptr);
+			Assert::IsTrue(y->get_parent() == nullptr);
 			Assert::IsTrue(y->right == c);
 			Assert::IsTrue(y->left == n);
 
 			// Assert n's peers
-			Assert::IsTrue(n->parent == y);
+			Assert::IsTrue(n->get_parent() == y);
 			Assert::IsTrue(n->right == b);
 			Assert::IsTrue(n->left == a);
 
 			// Assert a's peers
-			Assert::IsTrue(a->parent == n);
+			Assert::IsTrue(a->get_parent() == n);
 			Assert::IsTrue(a->right == nullptr);
 			Assert::IsTrue(a->left == nullptr);
 
 			// Assert c's peers
-			Assert::IsTrue(c->parent == y);
+			Assert::IsTrue(c->get_parent() == y);
 			Assert::IsTrue(c->right == nullptr);
 			Assert::IsTrue(c->left == nullptr);
 
 			// Assert b's peers
-			Assert::IsTrue(b->parent == n);
+			Assert::IsTrue(b->get_parent() == n);
 			Assert::IsTrue(b->right == nullptr);
 			Assert::IsTrue(b->left == nullptr);
 		}
@@ -100,27 +107,28 @@ namespace red_black_tree_tests
 			//	 / \
 			//	a	b
 
-			auto a = new node(0);
-			auto b = new node(0);
-			auto c = new node(0);
+			red_black_tree<int> tree;
+
+			auto a = tree.pool->allocate(0);
+			auto b = tree.pool->allocate(0);
+			auto c = tree.pool->allocate(0);
 
-			auto y = new node(0);
+			auto y = tree.pool->allocate(0);
 
 			y->left = a;
-			a->parent = y;
+			a->set_parent(y);
 
 			y->right = b;
-			b->parent = y;
+			b->set_parent(y);
 
-			auto n = new node(0);
+			auto n = tree.pool->allocate(0);
 
 			n->left = y;
-			y->parent = n;
+			y->set_parent(n);
 
 			n->right = c;
-			c->parent = n;
+			c->set_parent(n);
 
-			red_black_tree<int> tree;
 			tree.root = n;
 
 
@@ -140,27 +148,27 @@ namespace red_black_tree_tests
 
 			// Assert y's peers
 			Assert::IsTrue(tree.root == y);
-			Assert::IsTrue(y->parent == nullptr);
+			Assert::IsTrue(y->get_parent() == nullptr);
 			Assert::IsTrue(y->right == n);
 			Assert::IsTrue(y->left == a);
 
 			// Assert n's peers
-			Assert::IsTrue(n->parent == y);
+			Assert::IsTrue(n->get_parent() == y);
 			Assert::IsTrue(n->right == c);
 			Assert::IsTrue(n->left == b);
 
 			// Assert a's peers
-			Assert::IsTrue(a->parent == y);
+			Assert::IsTrue(a->get_parent() == y);
 			Assert::IsTrue(a->right == nullptr);
 			Assert::IsTrue(a->left == nullptr);
 
 			// Assert b's peers
-			Assert::IsTrue(b->parent == n);
+			Assert::IsTrue(b->get_parent() == n);
 			Assert::IsTrue(b->right == nullptr);
 			Assert::IsTrue(b->left == nullptr);
 
 			// Assert c's peers
-			Assert::IsTrue(c->parent == n);
+			Assert::IsTrue(c->get_parent() == n);
 			Assert::IsTrue(c->right == nullptr);
 			Assert::IsTrue(c->left == nullptr);
 		}
@@ -181,6 +189,37 @@ namespace red_black_tree_tests
 			Assert::IsTrue(result == expected_result);
 		}
 
+		TEST_METHOD(test_insert_rvalue)
+		{
+			red_black_tree<std::string> tree;
+
+			std::string payload(64, 'x');
+			const auto buffer = payload.data();
+
+			insert<std::string>(std::move(payload), tree);
+
+			// Assert the payload was moved into the node instead of copied
+			Assert::IsTrue(tree.root->data.data() == buffer);
+		}
+
+		TEST_METHOD(test_emplace)
+		{
+			red_black_tree<std::pair<int, std::string>> tree;
+
+			emplace_into(tree, 2, "two");
+			emplace_into(tree, 1, "one");
+			emplace_into(tree, 3, "three");
+
+			Assert::IsTrue(tree.root->data.second == "two");
+			Assert::IsTrue(tree.root->left->data.second == "one");
+			Assert::IsTrue(tree.root->right->data.second == "three");
+
+			// Assert duplicates are still rejected
+			Assert::ExpectException<std::runtime_error>([&tree]() {
+				emplace_into(tree, 2, "two");
+			});
+		}
+
 		TEST_METHOD(test_remove)
 		{
 			red_black_tree<int> tree;
@@ -203,6 +242,229 @@ namespace red_black_tree_tests
 			Assert::IsTrue(result == expected_result);
 		}
 
+		TEST_METHOD(test_remove_root_with_single_child)
+		{
+			red_black_tree<int> tree;
+
+			insert<int>(1, tree);
+			insert<int>(2, tree);
+
+			// The red child takes the root's place
+			remove<int>(1, tree);
+
+			Assert::IsTrue(tree.root->data == 2);
+			Assert::IsTrue(utils::get_color(tree.root) == color::black);
+
+			insert<int>(3, tree);
+			insert<int>(4, tree);
+
+			const std::vector<int> expected_result = { 3, 2, 4 };
+
+			std::vector<int> result = {};
+
+			traverse_level_order<int>(tree, [&result](const auto& data) {
+				result.push_back(data);
+			});
+
+			Assert::IsTrue(result == expected_result);
+		}
+
+		TEST_METHOD(test_remove_keeps_nodes)
+		{
+			red_black_tree<int> tree;
+			this->construct_full_tree(tree);
+
+			std::vector<const tree_node<int>*> nodes = {};
+
+			for (auto value = 0; value < 10; ++value) {
+				nodes.push_back(utils::find_node<int>(value, tree));
+			}
+
+			// The removed payloads all sit in nodes with two children
+			remove<int>(5, tree);
+			remove<int>(7, tree);
+
+			// Assert the remaining payloads stayed in their nodes
+			for (auto value = 0; value < 10; ++value) {
+
+				if (value == 5 || value == 7) continue;
+
+				Assert::IsTrue(utils::find_node<int>(value, tree) == nodes[value]);
+				Assert::IsTrue(nodes[value]->data == value);
+
+			}
+		}
+
+		TEST_METHOD(test_clear)
+		{
+			red_black_tree<int> tree;
+			this->construct_full_tree(tree);
+
+			std::set<const tree_node<int>*> nodes = {};
+
+			for (auto value = 0; value < 10; ++value) {
+				nodes.insert(utils::find_node<int>(value, tree));
+			}
+
+			clear(tree);
+
+			Assert::IsTrue(size(tree) == 0);
+			Assert::IsTrue(tree.begin() == tree.end());
+
+			this->construct_full_tree(tree);
+
+			// Assert the reload reused the nodes of the cleared content
+			for (auto value = 0; value < 10; ++value) {
+				Assert::IsTrue(nodes.count(utils::find_node<int>(value, tree)) == 1);
+			}
+		}
+
+		TEST_METHOD(test_clear_destructs_payloads)
+		{
+			red_black_tree<std::string> tree;
+
+			for (auto value = 0; value < 100; ++value) {
+				insert(std::to_string(value), tree);
+			}
+
+			clear(tree);
+
+			Assert::IsTrue(size(tree) == 0);
+			Assert::IsTrue(!find(std::string("42"), tree));
+
+			insert(std::string("42"), tree);
+
+			Assert::IsTrue(find(std::string("42"), tree));
+		}
+
+		TEST_METHOD(test_copy)
+		{
+			red_black_tree<int> tree;
+			this->construct_full_tree(tree);
+
+			const auto copy = tree;
+
+			std::vector<int> expected_result = {};
+			std::vector<color> expected_colors = {};
+			std::vector<int> result = {};
+			std::vector<color> colors = {};
+
+			traverse_level_order<int>(tree, [&expected_result](const auto& data) {
+				expected_result.push_back(data);
+			});
+
+			traverse_level_order<int>(copy, [&result](const auto& data) {
+				result.push_back(data);
+			});
+
+			for (auto value = 0; value < 10; ++value) {
+				expected_colors.push_back(utils::get_color(utils::find_node<int>(value, tree)));
+				colors.push_back(utils::get_color(utils::find_node<int>(value, copy)));
+			}
+
+			// Assert the copy has the same shape and colors, but nodes of its own
+			Assert::IsTrue(result == expected_result);
+			Assert::IsTrue(colors == expected_colors);
+			Assert::IsTrue(size(copy) == 10);
+			Assert::IsTrue(copy.rightmost->data == 9);
+			Assert::IsTrue(utils::find_node<int>(5, copy) != utils::find_node<int>(5, tree));
+
+			remove(5, tree);
+
+			Assert::IsTrue(find(5, copy));
+		}
+
+		TEST_METHOD(test_copy_large)
+		{
+			red_black_tree<int, std::less<int>, augmentations<order_statistics, multiplicity>> tree;
+
+			for (auto value = 0; value < 100000; ++value) {
+				insert(value, tree);
+			}
+
+			insert(42, tree);
+
+			auto copy = tree;
+
+			// Assert the metadata came along with the nodes
+			Assert::IsTrue(size(copy) == 100001);
+			Assert::IsTrue(count(42, copy) == 2);
+			Assert::IsTrue(*select(50000, copy) == 50000);
+			Assert::IsTrue(rank(99999, copy) == 99999);
+
+			// Assert the copy keeps working on its own
+			for (auto value = 0; value < 100000; value += 2) {
+				remove(value, copy);
+			}
+
+			Assert::IsTrue(size(copy) == 50001);
+			Assert::IsTrue(size(tree) == 100001);
+		}
+
+		TEST_METHOD(test_move)
+		{
+			std::vector<red_black_tree<int>> trees;
+
+			for (auto i = 0; i < 10; ++i) {
+
+				red_black_tree<int> tree;
+				this->construct_full_tree(tree);
+
+				remove(i, tree);
+
+				trees.push_back(std::move(tree));
+
+				// Assert the moved from tree is empty and usable, with memory of its own
+				Assert::IsTrue(size(tree) == 0);
+
+				insert(1, tree);
+
+				Assert::IsTrue(find(1, tree));
+				Assert::IsTrue(!shares_pool(trees.back(), tree));
+
+			}
+
+			for (auto i = 0; i < 10; ++i) {
+
+				Assert::IsTrue(size(trees[i]) == 9);
+				Assert::IsTrue(!find(i, trees[i]));
+
+			}
+
+			red_black_tree<int> target;
+			insert(100, target);
+
+			target = std::move(trees[0]);
+
+			Assert::IsTrue(size(target) == 9);
+			Assert::IsTrue(!find(100, target));
+
+			// Assert the tree moved from by assignment gets memory of its own
+			insert(100, trees[0]);
+
+			Assert::IsTrue(find(100, trees[0]));
+			Assert::IsTrue(!shares_pool(target, trees[0]));
+		}
+
+		TEST_METHOD(test_swap)
+		{
+			red_black_tree<int> a;
+			red_black_tree<int> b;
+
+			this->construct_full_tree(a);
+			insert(100, b);
+
+			const auto root = a.root;
+
+			swap(a, b);
+
+			// Assert the nodes changed hands without being touched
+			Assert::IsTrue(b.root == root);
+			Assert::IsTrue(size(a) == 1);
+			Assert::IsTrue(size(b) == 10);
+			Assert::IsTrue(a.rightmost->data == 100);
+		}
+
 		TEST_METHOD(test_find)
 		{
 			red_black_tree<int> tree;
@@ -225,6 +487,723 @@ namespace red_black_tree_tests
 			Assert::IsFalse(find<int>(11, tree));
 		}
 
+		TEST_METHOD(test_find_batch)
+		{
+			red_black_tree<int> tree;
+
+			for (auto value = 0; value < 1000; value += 3) {
+				insert(value, tree);
+			}
+
+			// More keys than a single group, and not a multiple of it
+			std::vector<int> keys = {};
+
+			for (auto key = -5; key < 1005; ++key) {
+				keys.push_back(key);
+			}
+
+			std::vector<bool> results = {};
+
+			find_batch(keys, results, tree);
+
+			Assert::IsTrue(results.size() == keys.size());
+
+			for (std::size_t i = 0; i < keys.size(); ++i) {
+				Assert::IsTrue(results[i] == find(keys[i], tree));
+			}
+
+			// Assert an empty tree finds nothing
+			red_black_tree<int> empty;
+
+			find_batch(keys, results, empty);
+
+			Assert::IsTrue(std::none_of(results.begin(), results.end(), [](const bool found) { return found; }));
+		}
+
+		TEST_METHOD(test_find_batch_transparent)
+		{
+			red_black_tree<std::string, std::less<>> tree;
+
+			insert(std::string("apple"), tree);
+			insert(std::string("cherry"), tree);
+
+			const std::vector<std::string_view> keys = { "cherry", "banana", "apple" };
+
+			std::vector<bool> results = {};
+
+			find_batch(keys, results, tree);
+
+			Assert::IsTrue(results == std::vector<bool>({ true, false, true }));
+		}
+
+		TEST_METHOD(test_custom_comparator)
+		{
+			red_black_tree<int, std::greater<int>> tree;
+
+			for (const auto value : { 3, 1, 4, 0, 2 }) {
+				insert(value, tree);
+			}
+
+			const std::vector<int> expected_result = { 4, 3, 2, 1, 0 };
+
+			std::vector<int> result = {};
+
+			traverse_in_order<int>(tree, [&result](const auto& data) {
+				result.push_back(data);
+			});
+
+			Assert::IsTrue(result == expected_result);
+			Assert::IsTrue(find(2, tree));
+			Assert::IsTrue(remove(2, tree));
+			Assert::IsFalse(find(2, tree));
+		}
+
+		TEST_METHOD(test_transparent_lookup)
+		{
+			red_black_tree<std::string, std::less<>> tree;
+
+			insert(std::string("alpha"), tree);
+			insert(std::string("beta"), tree);
+			insert(std::string("gamma"), tree);
+
+			// Look up with a string_view, without building a std::string key
+			Assert::IsTrue(find(std::string_view("beta"), tree));
+			Assert::IsFalse(find(std::string_view("delta"), tree));
+
+			Assert::IsTrue(remove(std::string_view("beta"), tree));
+			Assert::IsFalse(find(std::string_view("beta"), tree));
+		}
+
+		TEST_METHOD(test_assign)
+		{
+			const std::vector<int> values = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+			red_black_tree<int> tree;
+			insert<int>(42, tree);
+
+			assign(values.begin(), values.end(), tree);
+
+			//						b4
+			//			b1						  b7
+			//		b0		b2				b5			b8
+			//					r3				r6			r9
+
+			const std::vector<int> expected_result = { 4, 1, 7, 0, 2, 5, 8, 3, 6, 9 };
+
+			std::vector<int> result = {};
+
+			traverse_level_order<int>(tree, [&result](const auto& data) {
+				result.push_back(data);
+			});
+
+			Assert::IsTrue(result == expected_result);
+			Assert::IsTrue(utils::get_color(tree.root) == color::black);
+			Assert::IsTrue(utils::get_color(tree.root->right->right->right) == color::red);
+			Assert::IsFalse(find<int>(42, tree));
+		}
+
+		TEST_METHOD(test_assign_unsorted_range)
+		{
+			const std::vector<int> values = { 0, 2, 1 };
+
+			red_black_tree<int> tree;
+
+			Assert::ExpectException<std::invalid_argument>([&tree, &values]() {
+				assign(values.begin(), values.end(), tree);
+			});
+		}
+
+		TEST_METHOD(test_lower_bound)
+		{
+			red_black_tree<int> tree;
+
+			for (const auto value : { 0, 2, 4, 6, 8 }) {
+				insert(value, tree);
+			}
+
+			Assert::IsTrue(*lower_bound<int>(4, tree) == 4);
+			Assert::IsTrue(*lower_bound<int>(5, tree) == 6);
+			Assert::IsTrue(*lower_bound<int>(-1, tree) == 0);
+			Assert::IsTrue(lower_bound<int>(9, tree) == tree.end());
+		}
+
+		TEST_METHOD(test_upper_bound)
+		{
+			red_black_tree<int> tree;
+
+			for (const auto value : { 0, 2, 4, 6, 8 }) {
+				insert(value, tree);
+			}
+
+			Assert::IsTrue(*upper_bound<int>(4, tree) == 6);
+			Assert::IsTrue(*upper_bound<int>(5, tree) == 6);
+			Assert::IsTrue(*upper_bound<int>(-1, tree) == 0);
+			Assert::IsTrue(upper_bound<int>(8, tree) == tree.end());
+		}
+
+		TEST_METHOD(test_equal_range)
+		{
+			red_black_tree<int> tree;
+			this->construct_full_tree(tree);
+
+			const auto found = equal_range<int>(4, tree);
+
+			Assert::IsTrue(*found.first == 4);
+			Assert::IsTrue(*found.second == 5);
+
+			const auto missing = equal_range<int>(10, tree);
+
+			Assert::IsTrue(missing.first == tree.end());
+			Assert::IsTrue(missing.second == tree.end());
+		}
+
+		TEST_METHOD(test_size)
+		{
+			red_black_tree<int> tree;
+
+			Assert::IsTrue(size(tree) == 0);
+
+			this->construct_full_tree(tree);
+
+			Assert::IsTrue(size(tree) == 10);
+
+			remove<int>(5, tree);
+			remove<int>(42, tree);
+
+			Assert::IsTrue(size(tree) == 9);
+		}
+
+		TEST_METHOD(test_select)
+		{
+			red_black_tree<int, std::less<int>, order_statistics> tree;
+
+			for (const auto value : { 9, 1, 2, 7, 6, 3, 0, 5, 4, 8 }) {
+				insert(value * 10, tree);
+			}
+
+			Assert::IsTrue(*select(0, tree) == 0);
+			Assert::IsTrue(*select(4, tree) == 40);
+			Assert::IsTrue(*select(9, tree) == 90);
+			Assert::IsTrue(select(10, tree) == tree.end());
+		}
+
+		TEST_METHOD(test_rank)
+		{
+			red_black_tree<int, std::less<int>, order_statistics> tree;
+
+			for (const auto value : { 9, 1, 2, 7, 6, 3, 0, 5, 4, 8 }) {
+				insert(value * 10, tree);
+			}
+
+			Assert::IsTrue(rank(0, tree) == 0);
+			Assert::IsTrue(rank(40, tree) == 4);
+			Assert::IsTrue(rank(45, tree) == 5);
+			Assert::IsTrue(rank(1000, tree) == 10);
+		}
+
+		TEST_METHOD(test_aggregate_range)
+		{
+			struct sum {
+
+				using value_type = long long;
+
+				static value_type identity() { return 0; }
+				static value_type lift(const int& data) { return data; }
+				static value_type combine(const value_type& a, const value_type& b) { return a + b; }
+
+			};
+
+			red_black_tree<int, std::less<int>, aggregate<sum>> tree;
+
+			for (auto value = 0; value < 100; ++value) {
+				insert(value, tree);
+			}
+
+			Assert::IsTrue(aggregate_range(0, 100, tree) == 4950);
+			Assert::IsTrue(aggregate_range(10, 20, tree) == 145);
+			Assert::IsTrue(aggregate_range(-5, 1, tree) == 0);
+			Assert::IsTrue(aggregate_range(50, 50, tree) == 0);
+			Assert::IsTrue(aggregate_range(99, 1000, tree) == 99);
+		}
+
+		TEST_METHOD(test_insert_hint)
+		{
+			red_black_tree<int> tree;
+
+			// Appending at end() and chaining the returned iterators
+			auto position = tree.end();
+
+			for (auto value = 0; value < 100; value += 2) {
+				position = insert(tree.end(), value, tree);
+			}
+
+			Assert::IsTrue(*position == 98);
+
+			// A hint right after the payload's place
+			const auto inserted = insert(lower_bound(42, tree), 41, tree);
+
+			Assert::IsTrue(*inserted == 41);
+			Assert::IsTrue(*std::next(inserted) == 42);
+
+			// A wrong hint still inserts correctly
+			insert(tree.begin(), 77, tree);
+
+			Assert::IsTrue(find(77, tree));
+			Assert::IsTrue(size(tree) == 52);
+		}
+
+		TEST_METHOD(test_rightmost)
+		{
+			red_black_tree<int> tree;
+
+			Assert::IsTrue(tree.rightmost == nullptr);
+
+			this->construct_full_tree(tree);
+
+			Assert::IsTrue(tree.rightmost->data == 9);
+
+			insert(10, tree);
+
+			Assert::IsTrue(tree.rightmost->data == 10);
+
+			remove(10, tree);
+			remove(9, tree);
+
+			Assert::IsTrue(tree.rightmost->data == 8);
+		}
+
+		TEST_METHOD(test_try_insert)
+		{
+			red_black_tree<int> tree;
+
+			this->construct_full_tree(tree);
+
+			const auto inserted = try_insert(10, tree);
+
+			Assert::IsTrue(inserted.second);
+			Assert::IsTrue(*inserted.first == 10);
+
+			// Assert a duplicate is reported, not thrown
+			const auto duplicate = try_insert(5, tree);
+
+			Assert::IsTrue(!duplicate.second);
+			Assert::IsTrue(*duplicate.first == 5);
+			Assert::IsTrue(size(tree) == 11);
+		}
+
+		TEST_METHOD(test_multiset)
+		{
+			red_black_tree<int, std::less<int>, multiplicity> tree;
+
+			insert(3, tree);
+			insert(3, tree);
+			emplace_into(tree, 3);
+			insert(7, tree);
+
+			Assert::IsTrue(try_insert(7, tree).second);
+			Assert::IsTrue(count(3, tree) == 3);
+			Assert::IsTrue(count(7, tree) == 2);
+			Assert::IsTrue(count(5, tree) == 0);
+			Assert::IsTrue(size(tree) == 5);
+
+			// Assert removal counts down before the payload goes
+			remove(3, tree);
+			remove(3, tree);
+
+			Assert::IsTrue(count(3, tree) == 1);
+			Assert::IsTrue(find(3, tree));
+
+			remove(3, tree);
+
+			Assert::IsTrue(!find(3, tree));
+			Assert::IsTrue(size(tree) == 2);
+		}
+
+		TEST_METHOD(test_extract_insert)
+		{
+			red_black_tree<int> tree;
+			this->construct_full_tree(tree);
+
+			// A second tree drawing nodes from the same pool
+			red_black_tree<int> other(tree.pool, std::less<int>());
+
+			const auto node = utils::find_node<int>(5, tree);
+
+			auto handle = extract(5, tree);
+
+			Assert::IsTrue(handle.node == node);
+			Assert::IsTrue(!find(5, tree));
+			Assert::IsTrue(size(tree) == 9);
+
+			// Re-key the payload and move its node over
+			handle.value() = 50;
+
+			const auto position = insert(std::move(handle), other);
+
+			// Assert the very same node got linked in
+			Assert::IsTrue(handle.empty());
+			Assert::IsTrue(*position == 50);
+			Assert::IsTrue(utils::find_node<int>(50, other) == node);
+			Assert::IsTrue(size(other) == 1);
+
+			// Assert a missing payload yields an empty handle
+			Assert::IsTrue(extract(5, tree).empty());
+		}
+
+		TEST_METHOD(test_insert_handle_rejects)
+		{
+			red_black_tree<int> tree;
+			red_black_tree<int> foreign;
+
+			insert(1, tree);
+			insert(1, foreign);
+			insert(2, foreign);
+
+			auto duplicate = extract(1, foreign);
+
+			// Assert the handle stays filled when its payload is rejected
+			Assert::ExpectException<std::runtime_error>([&]() {
+				insert(std::move(duplicate), tree);
+			});
+
+			Assert::IsTrue(!duplicate.empty());
+			Assert::IsTrue(!shares_pool(tree, foreign));
+
+			insert(std::move(duplicate), foreign);
+
+			duplicate = extract(1, foreign);
+			extract(2, foreign);
+
+			red_black_tree<int> shared(foreign.pool, std::less<int>());
+			insert(1, shared);
+
+			Assert::ExpectException<std::runtime_error>([&]() {
+				insert(std::move(duplicate), shared);
+			});
+
+			Assert::IsTrue(!duplicate.empty());
+			Assert::IsTrue(size(shared) == 1);
+		}
+
+		TEST_METHOD(test_extract_insert_other_pool)
+		{
+			red_black_tree<int> source;
+			red_black_tree<int> target;
+
+			this->construct_full_tree(source);
+			insert(100, target);
+
+			// Move a node between trees that were constructed independently
+			auto handle = extract(5, source);
+
+			const auto position = insert(std::move(handle), target);
+
+			// Assert the payload moved over while the trees keep their memory apart
+			Assert::IsTrue(handle.empty());
+			Assert::IsTrue(*position == 5);
+			Assert::IsTrue(size(target) == 2);
+			Assert::IsTrue(!shares_pool(source, target));
+
+			// Assert both trees keep working on their own pools
+			insert(50, source);
+			remove(5, target);
+
+			Assert::IsTrue(find(50, source));
+			Assert::IsTrue(!find(5, target));
+			Assert::IsTrue(size(source) == 10);
+		}
+
+		TEST_METHOD(test_extract_multiset)
+		{
+			red_black_tree<int, std::less<int>, multiplicity> tree;
+			red_black_tree<int, std::less<int>, multiplicity> other(tree.pool, std::less<int>());
+
+			insert(3, tree);
+			insert(3, tree);
+			insert(4, tree);
+			insert(3, other);
+
+			// Assert the handle carries both counted payloads
+			auto handle = extract(3, tree);
+
+			Assert::IsTrue(size(tree) == 1);
+
+			insert(std::move(handle), other);
+
+			Assert::IsTrue(count(3, other) == 3);
+			Assert::IsTrue(size(other) == 3);
+
+			// Assert the count survives a move into a tree with a pool of its own
+			red_black_tree<int, std::less<int>, multiplicity> foreign;
+
+			insert(std::move(extract(3, other)), foreign);
+
+			Assert::IsTrue(count(3, foreign) == 3);
+			Assert::IsTrue(size(foreign) == 3);
+		}
+
+		TEST_METHOD(test_join)
+		{
+			red_black_tree<int> left;
+			red_black_tree<int> right;
+
+			for (auto value = 0; value < 5; ++value) {
+				insert(value, left);
+			}
+
+			for (auto value = 6; value < 50; ++value) {
+				insert(value, right);
+			}
+
+			join(left, 5, right);
+
+			// Assert every payload moved into left, in order
+			auto expected = 0;
+
+			for (const auto value : left) {
+				Assert::IsTrue(value == expected++);
+			}
+
+			Assert::IsTrue(expected == 50);
+			Assert::IsTrue(size(left) == 50);
+			Assert::IsTrue(size(right) == 0);
+			Assert::IsTrue(right.begin() == right.end());
+
+			// Assert the emptied tree does not allocate from the joined one's memory
+			Assert::IsTrue(!shares_pool(left, right));
+
+			// Assert the joined tree keeps working
+			remove(25, left);
+			insert(50, left);
+
+			Assert::IsTrue(!find(25, left));
+			Assert::IsTrue(find(50, left));
+		}
+
+		TEST_METHOD(test_join_unordered)
+		{
+			red_black_tree<int> left;
+			red_black_tree<int> right;
+
+			insert(5, left);
+			insert(3, right);
+
+			auto threw = false;
+
+			try {
+				join(left, 4, right);
+			}
+
+			catch (const std::invalid_argument&) {
+				threw = true;
+			}
+
+			Assert::IsTrue(threw);
+			Assert::IsTrue(size(left) == 1);
+			Assert::IsTrue(size(right) == 1);
+		}
+
+		TEST_METHOD(test_split)
+		{
+			red_black_tree<int> tree;
+			red_black_tree<int> right;
+
+			this->construct_full_tree(tree);
+			insert(42, right);
+
+			split(4, tree, right);
+
+			// Assert the payloads before the key stay, the others move
+			auto expected = 0;
+
+			for (const auto value : tree) {
+				Assert::IsTrue(value == expected++);
+			}
+
+			Assert::IsTrue(expected == 4);
+
+			for (const auto value : right) {
+				Assert::IsTrue(value == expected++);
+			}
+
+			Assert::IsTrue(expected == 10);
+			Assert::IsTrue(size(tree) == 4);
+			Assert::IsTrue(size(right) == 6);
+
+			// Assert the halves are reported as sharing their memory
+			Assert::IsTrue(shares_pool(tree, right));
+
+			// Assert a tree cannot be split into itself
+			Assert::ExpectException<std::invalid_argument>([&]() {
+				split(2, tree, tree);
+			});
+
+			Assert::IsTrue(size(tree) == 4);
+			Assert::IsTrue(find(3, tree));
+		}
+
+		TEST_METHOD(test_split_order_statistics)
+		{
+			red_black_tree<int, std::less<int>, order_statistics> tree;
+			red_black_tree<int, std::less<int>, order_statistics> right;
+
+			for (auto value = 0; value < 100; ++value) {
+				insert(value, tree);
+			}
+
+			split(30, tree, right);
+
+			Assert::IsTrue(size(tree) == 30);
+			Assert::IsTrue(size(right) == 70);
+			Assert::IsTrue(*select(0, right) == 30);
+			Assert::IsTrue(rank(60, right) == 30);
+			Assert::IsTrue(*select(29, tree) == 29);
+		}
+
+		TEST_METHOD(test_set_union)
+		{
+			red_black_tree<int> a;
+			red_black_tree<int> b;
+			red_black_tree<int> result;
+
+			for (auto value = 0; value < 100; value += 2) {
+				insert(value, a);
+			}
+
+			for (auto value = 0; value < 100; value += 3) {
+				insert(value, b);
+			}
+
+			set_union(a, b, result);
+
+			// Assert every multiple of 2 or 3 is present once, and the inputs were consumed
+			auto count = 0;
+
+			for (auto value = 0; value < 100; ++value) {
+
+				const auto expected = value % 2 == 0 || value % 3 == 0;
+
+				Assert::IsTrue(find(value, result) == expected);
+				count += expected ? 1 : 0;
+
+			}
+
+			Assert::IsTrue(size(result) == static_cast<std::size_t>(count));
+			Assert::IsTrue(size(a) == 0);
+			Assert::IsTrue(size(b) == 0);
+		}
+
+		TEST_METHOD(test_set_intersection)
+		{
+			red_black_tree<int> a;
+			red_black_tree<int> b;
+			red_black_tree<int> result;
+
+			for (auto value = 0; value < 100; value += 2) {
+				insert(value, a);
+			}
+
+			for (auto value = 0; value < 100; value += 3) {
+				insert(value, b);
+			}
+
+			set_intersection(a, b, result);
+
+			// Assert exactly the multiples of 6 remain
+			auto expected = 0;
+
+			for (const auto value : result) {
+				Assert::IsTrue(value == expected);
+				expected += 6;
+			}
+
+			Assert::IsTrue(expected == 102);
+			Assert::IsTrue(size(result) == 17);
+		}
+
+		TEST_METHOD(test_set_difference)
+		{
+			red_black_tree<int> a;
+			red_black_tree<int> b;
+
+			for (auto value = 0; value < 100; ++value) {
+				insert(value, a);
+			}
+
+			for (auto value = 10; value < 90; ++value) {
+				insert(value, b);
+			}
+
+			// The result may replace one of the inputs
+			set_difference(a, b, a);
+
+			Assert::IsTrue(size(a) == 20);
+			Assert::IsTrue(find(9, a));
+			Assert::IsTrue(!find(10, a));
+			Assert::IsTrue(!find(89, a));
+			Assert::IsTrue(find(90, a));
+
+			// Assert the emptied input allocates on its own
+			Assert::IsTrue(size(b) == 0);
+			Assert::IsTrue(!shares_pool(a, b));
+		}
+
+		TEST_METHOD(test_set_operations_on_copies)
+		{
+			red_black_tree<int> a;
+			red_black_tree<int> b;
+
+			for (auto value = 0; value < 100; value += 2) {
+				insert(value, a);
+			}
+
+			for (auto value = 0; value < 100; value += 3) {
+				insert(value, b);
+			}
+
+			const auto united = set_union(a, b);
+			const auto intersected = set_intersection(a, b);
+			const auto difference = set_difference(a, b);
+
+			Assert::IsTrue(size(united) == 67);
+			Assert::IsTrue(size(intersected) == 17);
+			Assert::IsTrue(size(difference) == 33);
+			Assert::IsTrue(find(9, united));
+			Assert::IsTrue(find(6, intersected));
+			Assert::IsTrue(!find(6, difference));
+
+			// Assert the inputs were left untouched
+			Assert::IsTrue(size(a) == 50);
+			Assert::IsTrue(size(b) == 34);
+			Assert::IsTrue(size(set_difference(a, a)) == 0);
+			Assert::IsTrue(size(a) == 50);
+		}
+
+		TEST_METHOD(test_set_operations_on_itself)
+		{
+			red_black_tree<int> tree;
+			red_black_tree<int> result;
+
+			this->construct_full_tree(tree);
+
+			// Assert union and intersection keep the tree as it is
+			set_union(tree, tree, tree);
+
+			Assert::IsTrue(size(tree) == 10);
+
+			set_intersection(tree, tree, result);
+
+			Assert::IsTrue(size(result) == 10);
+			Assert::IsTrue(size(tree) == 0);
+			Assert::IsTrue(find(9, result));
+
+			// Assert the difference empties it
+			set_difference(result, result, result);
+
+			Assert::IsTrue(size(result) == 0);
+			Assert::IsTrue(result.begin() == result.end());
+		}
+
 	private:
 
 		void construct_full_tree(
@@ -0,0 +1,139 @@
+#include "CppUnitTest.h"
+
+#include "sharded_red_black_tree.h"
+
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace red_black_tree_tests
+{
+	TEST_CLASS(test_sharded_red_black_tree)
+	{
+	public:
+
+		TEST_METHOD(test_insert_find_remove)
+		{
+			sharded_red_black_tree<int> tree(4);
+
+			for (auto value = 0; value < 100; ++value) {
+				insert(value, tree);
+			}
+
+			Assert::IsTrue(size(tree) == 100);
+			Assert::IsTrue(find(42, tree));
+
+			Assert::IsTrue(remove(42, tree));
+			Assert::IsTrue(!remove(42, tree));
+
+			Assert::IsTrue(!find(42, tree));
+			Assert::IsTrue(size(tree) == 99);
+		}
+
+		TEST_METHOD(test_rebalance_on_skew)
+		{
+			sharded_red_black_tree<int> tree(4);
+
+			// Ascending payloads all land in the last shard until the boundaries move
+			for (auto value = 0; value < 10000; ++value) {
+				insert(value, tree);
+			}
+
+			// Assert no shard holds much more than its share
+			for (const auto& current_shard : tree.shards) {
+				Assert::IsTrue(size(current_shard->tree) <= 2 * 10000 / 4);
+			}
+
+			for (auto value = 0; value < 10000; ++value) {
+				Assert::IsTrue(find(value, tree));
+			}
+		}
+
+		TEST_METHOD(test_rebalance_moves_boundary_range)
+		{
+			sharded_red_black_tree<int> tree(4);
+
+			// Past the first rebalance the boundaries exist
+			for (auto value = 0; value < 2000; ++value) {
+				insert(value, tree);
+			}
+
+			const auto first_shard = size(tree.shards[0]->tree);
+
+			for (auto value = 2000; value < 10000; ++value) {
+				insert(value, tree);
+			}
+
+			// Assert later rebalances left the shard far from the inserts alone
+			Assert::IsTrue(size(tree.shards[0]->tree) == first_shard);
+			Assert::IsTrue(size(tree) == 10000);
+		}
+
+		TEST_METHOD(test_rebalance_two_shards)
+		{
+			sharded_red_black_tree<int> tree(2);
+
+			for (auto value = 0; value < 10000; ++value) {
+				insert(value, tree);
+			}
+
+			// Assert neither shard holds more than twice what the other one does
+			for (const auto& current_shard : tree.shards) {
+				Assert::IsTrue(size(current_shard->tree) <= 2 * 10000 / 3 + 1);
+			}
+
+			Assert::IsTrue(size(tree) == 10000);
+		}
+
+		TEST_METHOD(test_collect_range)
+		{
+			sharded_red_black_tree<int> tree(4);
+
+			for (auto value = 0; value < 5000; ++value) {
+				insert(value * 2, tree);
+			}
+
+			rebalance(tree);
+
+			const auto payloads = collect_range(101, 9001, tree);
+
+			// Assert the range came back complete and in order across the shards
+			Assert::IsTrue(payloads.size() == 4450);
+
+			for (std::size_t i = 0; i < payloads.size(); ++i) {
+				Assert::IsTrue(payloads[i] == 102 + 2 * static_cast<int>(i));
+			}
+		}
+
+		TEST_METHOD(test_concurrent_writers)
+		{
+			sharded_red_black_tree<int> tree(4);
+
+			std::vector<std::thread> writers;
+
+			for (auto writer = 0; writer < 4; ++writer) {
+
+				writers.emplace_back([&tree, writer]() {
+
+					for (auto value = 0; value < 5000; ++value) {
+						insert(value * 4 + writer, tree);
+					}
+
+				});
+
+			}
+
+			for (auto& writer : writers) {
+				writer.join();
+			}
+
+			Assert::IsTrue(size(tree) == 20000);
+
+			for (auto value = 0; value < 20000; ++value) {
+				Assert::IsTrue(find(value, tree));
+			}
+		}
+
+	};
+}
\ No newline at end of file
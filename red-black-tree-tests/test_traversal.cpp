@@ -84,5 +84,70 @@ namespace red_black_tree_tests
 			Assert::IsTrue(result == expected_result);
 		}
 
+		TEST_METHOD(test_traverse_stops_early)
+		{
+			const std::vector<int> expected_result = { 0, 1, 2, 3 };
+
+			std::vector<int> result = {};
+
+			// Returning false stops the traversal
+			const auto completed = traverse_in_order<int>(this->tree, [&result](const auto& data) {
+				result.push_back(data);
+				return data < 3;
+			});
+
+			Assert::IsFalse(completed);
+			Assert::IsTrue(result == expected_result);
+		}
+
+		TEST_METHOD(test_traverse_level_order_reuses_buffer)
+		{
+			const std::vector<int> expected_result = { 3, 1, 5, 0, 2, 4, 7, 6, 8, 9 };
+
+			level_order_buffer<int> buffer;
+
+			for (auto i = 0; i < 2; ++i) {
+
+				std::vector<int> result = {};
+
+				traverse_level_order<int>(this->tree, [&result](const auto& data) {
+					result.push_back(data);
+				}, buffer);
+
+				Assert::IsTrue(result == expected_result);
+			}
+
+			Assert::IsTrue(buffer.current_level.capacity() > 0);
+		}
+
+		TEST_METHOD(test_traverse_with_process)
+		{
+			const std::vector<int> expected_result = { 0, 2, 1, 4, 6, 9, 8, 7, 5, 3 };
+
+			std::vector<int> result = {};
+
+			// Type erased visitors remain supported
+			const process<int> visitor = [&result](const int& data) {
+				result.push_back(data);
+			};
+
+			Assert::IsTrue(traverse_post_order<int>(this->tree, visitor));
+			Assert::IsTrue(result == expected_result);
+		}
+
+		TEST_METHOD(test_for_each_in_range)
+		{
+			const std::vector<int> expected_result = { 3, 4, 5, 6 };
+
+			std::vector<int> result = {};
+
+			const auto completed = for_each_in_range(3, 7, this->tree, [&result](const auto& data) {
+				result.push_back(data);
+			});
+
+			Assert::IsTrue(completed);
+			Assert::IsTrue(result == expected_result);
+		}
+
 	};
 }
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "CppUnitTest.h"
+
+#include "red_black_tree.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace red_black_tree_tests
+{
+	TEST_CLASS(test_tree_iterator)
+	{
+	public:
+
+		red_black_tree<int> tree;
+
+		test_tree_iterator()
+		{
+			insert<int>(9, this->tree);
+			insert<int>(1, this->tree);
+			insert<int>(2, this->tree);
+			insert<int>(7, this->tree);
+			insert<int>(6, this->tree);
+			insert<int>(3, this->tree);
+			insert<int>(0, this->tree);
+			insert<int>(5, this->tree);
+			insert<int>(4, this->tree);
+			insert<int>(8, this->tree);
+		}
+
+		TEST_METHOD(test_forward_iteration)
+		{
+			const std::vector<int> expected_result = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+			std::vector<int> result = {};
+
+			for (const auto& data : this->tree) {
+				result.push_back(data);
+			}
+
+			Assert::IsTrue(result == expected_result);
+		}
+
+		TEST_METHOD(test_reverse_iteration)
+		{
+			const std::vector<int> expected_result = { 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 };
+
+			const std::vector<int> result(this->tree.rbegin(), this->tree.rend());
+
+			Assert::IsTrue(result == expected_result);
+		}
+
+		TEST_METHOD(test_decrement_from_end)
+		{
+			auto iterator = this->tree.end();
+
+			Assert::IsTrue(*--iterator == 9);
+			Assert::IsTrue(*--iterator == 8);
+			Assert::IsTrue(*iterator++ == 8);
+			Assert::IsTrue(++iterator == this->tree.end());
+		}
+
+		TEST_METHOD(test_algorithms)
+		{
+			// Stop at the first match instead of visiting every node
+			const auto match = std::find_if(this->tree.begin(), this->tree.end(), [](const int data) {
+				return data > 4;
+			});
+
+			Assert::IsTrue(*match == 5);
+			Assert::IsTrue(std::distance(this->tree.begin(), match) == 5);
+		}
+
+		TEST_METHOD(test_empty_tree)
+		{
+			const red_black_tree<int> empty_tree;
+
+			Assert::IsTrue(empty_tree.begin() == empty_tree.end());
+			Assert::IsTrue(empty_tree.rbegin() == empty_tree.rend());
+		}
+
+	};
+}
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "tree_node.h"
 
+#include <string>
+
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 namespace red_black_tree_tests
@@ -60,6 +62,19 @@ namespace red_black_tree_tests
 			Assert::IsTrue(moved.right == &node);
 		}
 
+		TEST_METHOD(test_move_constructor_moves_data)
+		{
+			tree_node<std::string> node(std::string(64, 'x'));
+			const auto buffer = node.data.data();
+
+			// Call the move constructor
+			const auto moved = std::move(node);
+
+			// Assert the payload's storage changed hands
+			Assert::IsTrue(moved.data.data() == buffer);
+			Assert::IsTrue(moved.data == std::string(64, 'x'));
+		}
+
 		TEST_METHOD(test_copy_assignment)
 		{
 			tree_node<int> node_0(691);
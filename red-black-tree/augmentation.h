@@ -0,0 +1,165 @@
+#pragma once
+
+#include "red_black_node.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace utils {
+
+	template <typename node_t, typename t>
+	std::size_t subtree_size(
+		const tree_node<t>* const node) noexcept {
+
+		// Nil nodes hold no nodes
+		if (!node) return 0;
+
+		return static_cast<const node_t*>(node)->subtree_size;
+
+	}
+
+	template <typename node_t, typename t>
+	auto subtree_aggregate(
+		const tree_node<t>* const node) {
+
+		using monoid = typename node_t::monoid_type;
+
+		// Nil nodes hold the identity
+		if (!node) return monoid::identity();
+
+		return static_cast<const node_t*>(node)->subtree_aggregate;
+
+	}
+
+}
+
+namespace {
+
+	// Default policy, nodes carry no metadata and nothing is maintained
+	struct no_augmentation {};
+
+	// Stores the number of nodes in the subtree rooted at each node
+	// Enables select and rank in O(log n)
+	struct order_statistics {
+
+		std::size_t subtree_size = 1;
+
+		template <typename node_t>
+		static void update(
+			node_t& node) noexcept {
+
+			node.subtree_size = 1 +
+				utils::subtree_size<node_t>(node.left.get()) +
+				utils::subtree_size<node_t>(node.right.get());
+
+		}
+
+	};
+
+	// Stores how many equivalent payloads each node stands for, turning the tree into a multiset
+	// Inserting a duplicate counts it up instead of failing, removing one counts it down
+	// Iterators visit and aggregates fold a node once for every payload it stands for, while
+	// order_statistics keeps counting nodes
+	struct multiplicity {
+
+		std::size_t count = 1;
+
+		template <typename node_t>
+		static void update(
+			node_t&) noexcept {}
+
+	};
+
+	// Stores monoid::combine folded over the payloads of each subtree, in order
+	// Enables aggregate_range in O(log n)
+	//
+	// monoid provides
+	//	value_type
+	//	static value_type identity()
+	//	static value_type lift(const t& data)
+	//	static value_type combine(const value_type& a, const value_type& b), associative
+	template <typename monoid>
+	struct aggregate {
+
+		using monoid_type = monoid;
+
+		typename monoid::value_type subtree_aggregate = monoid::identity();
+
+		template <typename node_t>
+		static void update(
+			node_t& node) {
+
+			node.subtree_aggregate = monoid::combine(
+				monoid::combine(utils::subtree_aggregate<node_t>(node.left.get()), lift_node(node)),
+				utils::subtree_aggregate<node_t>(node.right.get()));
+
+		}
+
+		// The payload of node lifted into the monoid, folded once for every payload a multiset node stands for
+		template <typename node_t>
+		static auto lift_node(
+			const node_t& node) {
+
+			if constexpr (std::is_base_of<multiplicity, node_t>::value) {
+
+				// Squares its way through the bits of the count, so that takes O(log count) combines
+				auto result = monoid::identity();
+				auto power = monoid::lift(node.data);
+
+				for (auto count = node.count;;) {
+
+					if (count & 1) result = monoid::combine(result, power);
+
+					count >>= 1;
+
+					if (!count) return result;
+
+					power = monoid::combine(power, power);
+
+				}
+
+			}
+
+			else {
+				return monoid::lift(node.data);
+			}
+
+		}
+
+	};
+
+	// Maintains several policies side by side, e.g. augmentations<order_statistics, aggregate<sum>>
+	template <typename... policies>
+	struct augmentations : public policies... {
+
+		template <typename node_t>
+		static void update(
+			node_t& node) {
+
+			(policies::update(node), ...);
+
+		}
+
+	};
+
+	// An augmentation policy is any default constructible type holding the per node metadata
+	// along with a static update(node_t& node) recomputing it from node.data and its children
+	// The children are always up to date when a node is updated
+
+	// A red black node extended with the metadata of an augmentation policy
+	// The red black node stays a base, so the balancing code keeps working on red_black_node<t>
+	template <typename t, typename augment>
+	struct augmented_node : public red_black_node<t>, public augment {
+
+		// Forwards to the constructors of red_black_node<t>
+		template <typename... args>
+		explicit augmented_node(
+			args&&... arguments) noexcept(std::is_nothrow_constructible<red_black_node<t>, args...>::value) :
+
+			red_black_node<t>(std::forward<args>(arguments)...),
+			augment() {}
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,329 @@
+#pragma once
+
+#include "epoch_reclamation.h"
+#include "red_black_tree.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+	// A red_black_tree for many readers and few writers
+	// Writers are serialized by a mutex, readers never lock: they descend speculatively and validate the
+	// descent against a sequence counter, retrying if a writer ran in the meantime
+	template <typename t, typename compare = std::less<t>>
+	struct concurrent_red_black_tree {
+
+		// Readers copy payloads of nodes a writer may be retiring underneath them
+		static_assert(std::is_trivially_copyable<t>::value,
+			"concurrent_red_black_tree requires a trivially copyable payload");
+
+		red_black_tree<t, compare> tree;
+
+		// Even while the tree is stable, odd while a writer changes it
+		std::atomic<std::size_t> version;
+
+		// The root and size of tree as of the last completed write, the fields of tree itself are only
+		// touched by writers
+		// Readers follow the child links through node_link::acquire, so every node they reach was fully
+		// built before it got linked
+		std::atomic<const tree_node<t>*> root;
+		std::atomic<std::size_t> count;
+
+		// Serializes the writers
+		std::mutex writer;
+
+		// Readers register in an epoch, so that nodes unlinked by remove are only recycled once
+		// no reader can still be on them
+		mutable epoch_domain epochs;
+
+		// Nodes unlinked by remove along with the epoch they were unlinked in
+		std::vector<std::pair<red_black_node<t>*, std::uint64_t>> retired;
+
+		concurrent_red_black_tree() :
+
+			tree(),
+			version(0),
+			root(nullptr),
+			count(0) {}
+
+		explicit concurrent_red_black_tree(
+			const compare& comparator) :
+
+			tree(comparator),
+			version(0),
+			root(nullptr),
+			count(0) {}
+
+		// Copy constructor
+		concurrent_red_black_tree(
+			const concurrent_red_black_tree& other) = delete;
+
+		// Move constructor
+		concurrent_red_black_tree(
+			concurrent_red_black_tree&& other) = delete;
+
+		// Copy assignment
+		concurrent_red_black_tree& operator=(
+			const concurrent_red_black_tree& other) = delete;
+
+		// Move assignment
+		concurrent_red_black_tree& operator=(
+			concurrent_red_black_tree&& other) = delete;
+
+	};
+
+}
+
+namespace utils {
+
+	// A path longer than any red-black tree can hold means the reader ran into a restructure
+	constexpr std::size_t max_read_steps = 128;
+
+	// Retired nodes are only scanned for reuse once this many piled up
+	constexpr std::size_t reclaim_threshold = 64;
+
+	// Marks the version odd for the lifetime of a write, holding the writer mutex
+	template <typename t, typename compare>
+	struct write_section {
+
+		std::lock_guard<std::mutex> lock;
+		concurrent_red_black_tree<t, compare>& tree;
+
+		explicit write_section(
+			concurrent_red_black_tree<t, compare>& tree) :
+
+			lock(tree.writer),
+			tree(tree) {
+
+			this->tree.version.store(this->tree.version.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+		}
+
+		~write_section() {
+
+			this->tree.root.store(this->tree.tree.root, std::memory_order_release);
+			this->tree.count.store(this->tree.tree.element_count, std::memory_order_relaxed);
+
+			this->tree.version.store(this->tree.version.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+		}
+
+	};
+
+	template <typename t, typename compare, typename reader>
+	auto read_validated(
+		const concurrent_red_black_tree<t, compare>& tree,
+		reader&& read) {
+
+		// Runs read until it completes without a writer running at the same time
+		// read returns an empty optional when it gave up on a path that cannot be valid
+		// Every speculative read is atomic, so a concurrent writer only makes it stale, never undefined;
+		// nothing it produces is used before validation
+
+		while (true) {
+
+			const auto start = tree.version.load(std::memory_order_acquire);
+
+			if (start & 1) {
+
+				std::this_thread::yield();
+				continue;
+
+			}
+
+			epoch_guard guard(tree.epochs);
+
+			auto result = read();
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (result && tree.version.load(std::memory_order_relaxed) == start) {
+				return *result;
+			}
+
+		}
+
+	}
+
+	template <typename t, typename compare, typename key_t>
+	std::optional<t> lookup_payload(
+		const key_t& key,
+		const concurrent_red_black_tree<t, compare>& tree) {
+
+		// Descends like find_node, copying every payload before comparing it
+
+		return read_validated(tree, [&]() -> std::optional<std::optional<t>> {
+
+			const tree_node<t>* current_node = tree.root.load(std::memory_order_acquire);
+			std::optional<t> candidate;
+			std::size_t steps = 0;
+
+			while (current_node) {
+
+				if (++steps > max_read_steps) return std::nullopt;
+
+				const t data = current_node->data;
+
+				if (tree.tree.comparator(data, key)) {
+					current_node = current_node->right.acquire();
+				}
+
+				else {
+					candidate = data;
+					current_node = current_node->left.acquire();
+				}
+
+			}
+
+			if (candidate && tree.tree.comparator(key, *candidate)) {
+				candidate.reset();
+			}
+
+			return candidate;
+
+		});
+
+	}
+
+	template <typename t, typename compare>
+	void reclaim_retired(
+		concurrent_red_black_tree<t, compare>& tree) {
+
+		// Hands the retired nodes no reader can reach anymore back to the pool, the writer mutex has to be held
+
+		if (tree.retired.size() < reclaim_threshold) return;
+
+		tree.epochs.try_advance();
+
+		std::size_t kept = 0;
+
+		for (const auto& entry : tree.retired) {
+
+			if (tree.epochs.is_safe(entry.second)) {
+				release_node<t>(tree.tree, entry.first);
+			}
+
+			else {
+				tree.retired[kept++] = entry;
+			}
+
+		}
+
+		tree.retired.resize(kept);
+
+	}
+
+	template <typename t, typename compare, typename key_t>
+	bool remove_payload(
+		const key_t& key,
+		concurrent_red_black_tree<t, compare>& tree) {
+
+		write_section<t, compare> section(tree);
+
+		const auto target_node = find_node<t>(key, tree.tree);
+
+		if (!target_node) {
+			return false;
+		}
+
+		tree.retired.emplace_back(unlink_node<t>(tree.tree, target_node), tree.epochs.global_epoch.load());
+
+		reclaim_retired<t>(tree);
+
+		return true;
+
+	}
+
+}
+
+namespace {
+
+	template <typename t, typename compare>
+	void insert(
+		const t& data,
+		concurrent_red_black_tree<t, compare>& tree) {
+
+		utils::write_section<t, compare> section(tree);
+
+		insert<t>(data, tree.tree);
+
+	}
+
+	template <typename t, typename compare>
+	bool remove(
+		const t& data,
+		concurrent_red_black_tree<t, compare>& tree) {
+
+		return utils::remove_payload<t>(data, tree);
+
+	}
+
+	template <typename t, typename compare, typename key_t,
+		typename = std::enable_if_t<utils::is_transparent<compare>::value>>
+	bool remove(
+		const key_t& key,
+		concurrent_red_black_tree<t, compare>& tree) {
+
+		return utils::remove_payload<t>(key, tree);
+
+	}
+
+	template <typename t, typename compare>
+	bool find(
+		const t& data,
+		const concurrent_red_black_tree<t, compare>& tree) {
+
+		return utils::lookup_payload<t>(data, tree).has_value();
+
+	}
+
+	template <typename t, typename compare, typename key_t,
+		typename = std::enable_if_t<utils::is_transparent<compare>::value>>
+	bool find(
+		const key_t& key,
+		const concurrent_red_black_tree<t, compare>& tree) {
+
+		return utils::lookup_payload<t>(key, tree).has_value();
+
+	}
+
+	template <typename t, typename compare>
+	std::optional<t> lookup(
+		const t& data,
+		const concurrent_red_black_tree<t, compare>& tree) {
+
+		// Copies the stored payload equivalent to data, if any
+
+		return utils::lookup_payload<t>(data, tree);
+
+	}
+
+	template <typename t, typename compare, typename key_t,
+		typename = std::enable_if_t<utils::is_transparent<compare>::value>>
+	std::optional<t> lookup(
+		const key_t& key,
+		const concurrent_red_black_tree<t, compare>& tree) {
+
+		return utils::lookup_payload<t>(key, tree);
+
+	}
+
+	template <typename t, typename compare>
+	std::size_t size(
+		const concurrent_red_black_tree<t, compare>& tree) {
+
+		return tree.count.load(std::memory_order_relaxed);
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+namespace {
+
+	// Tracks which epochs readers are in, so that memory unlinked in an epoch can be reused
+	// once no reader that entered up to that epoch is still around
+	//
+	// Memory retired in epoch e is safe to reuse from epoch e + 2 on: advancing from epoch e to e + 1
+	// requires every reader of epoch e - 1 to have left, so readers only ever span two adjacent epochs
+	// and three reader counts suffice
+	struct epoch_domain {
+
+		// Readers are spread over striped counts to keep them from contending on one cache line
+		static constexpr std::size_t stripe_count = 64;
+
+		struct alignas(64) stripe {
+
+			std::atomic<std::size_t> readers[3];
+
+		};
+
+		std::atomic<std::uint64_t> global_epoch;
+		stripe stripes[stripe_count];
+
+		epoch_domain() noexcept :
+
+			global_epoch(0) {
+
+			for (auto& current_stripe : this->stripes) {
+
+				for (auto& count : current_stripe.readers) {
+					count.store(0, std::memory_order_relaxed);
+				}
+
+			}
+
+		}
+
+		// Copy constructor
+		epoch_domain(
+			const epoch_domain& other) = delete;
+
+		// Move constructor
+		epoch_domain(
+			epoch_domain&& other) = delete;
+
+		// Copy assignment
+		epoch_domain& operator=(
+			const epoch_domain& other) = delete;
+
+		// Move assignment
+		epoch_domain& operator=(
+			epoch_domain&& other) = delete;
+
+		static stripe& local_stripe(
+			epoch_domain& domain) noexcept {
+
+			thread_local const auto index = std::hash<std::thread::id>()(std::this_thread::get_id()) % stripe_count;
+
+			return domain.stripes[index];
+
+		}
+
+		std::uint64_t enter() noexcept {
+
+			// Registers the calling thread as a reader of the current epoch and returns that epoch
+
+			auto& current_stripe = local_stripe(*this);
+
+			while (true) {
+
+				const auto epoch = this->global_epoch.load();
+
+				current_stripe.readers[epoch % 3].fetch_add(1);
+
+				// The epoch moved on before the reader was counted, it has to join the new one
+				if (this->global_epoch.load() == epoch) {
+					return epoch;
+				}
+
+				current_stripe.readers[epoch % 3].fetch_sub(1);
+
+			}
+
+		}
+
+		void leave(
+			const std::uint64_t epoch) noexcept {
+
+			local_stripe(*this).readers[epoch % 3].fetch_sub(1, std::memory_order_release);
+
+		}
+
+		bool try_advance() noexcept {
+
+			// Moves to the next epoch if no reader is left in the previous one
+
+			const auto epoch = this->global_epoch.load();
+
+			for (auto& current_stripe : this->stripes) {
+
+				if (current_stripe.readers[(epoch + 2) % 3].load() != 0) {
+					return false;
+				}
+
+			}
+
+			this->global_epoch.store(epoch + 1);
+
+			return true;
+
+		}
+
+		bool is_safe(
+			const std::uint64_t retire_epoch) const noexcept {
+
+			// Whether no reader can still hold memory retired in retire_epoch
+
+			return this->global_epoch.load() >= retire_epoch + 2;
+
+		}
+
+	};
+
+	// Keeps the calling thread registered as a reader for its lifetime
+	struct epoch_guard {
+
+		epoch_domain& domain;
+		const std::uint64_t epoch;
+
+		explicit epoch_guard(
+			epoch_domain& domain) noexcept :
+
+			domain(domain),
+			epoch(domain.enter()) {}
+
+		// Copy constructor
+		epoch_guard(
+			const epoch_guard& other) = delete;
+
+		// Destructor
+		~epoch_guard() {
+
+			this->domain.leave(this->epoch);
+
+		}
+
+		// Copy assignment
+		epoch_guard& operator=(
+			const epoch_guard& other) = delete;
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,306 @@
+#pragma once
+
+#include "red_black_tree.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace utils {
+
+	constexpr std::size_t cache_line_bytes = 64;
+
+	// Places an array so that the element before its first one would start a cache line
+	// Counting positions from 1, position k then sits k elements past a line boundary, and the
+	// descendants the descent prefetches together, positions k * stride onwards, fill exactly one line
+	template <typename t>
+	struct cache_line_allocator {
+
+		using value_type = t;
+
+		static constexpr std::size_t alignment = alignof(t) > cache_line_bytes ? alignof(t) : cache_line_bytes;
+		static constexpr std::size_t offset = sizeof(t);
+
+		cache_line_allocator() noexcept = default;
+
+		template <typename other_t>
+		cache_line_allocator(
+			const cache_line_allocator<other_t>&) noexcept {}
+
+		t* allocate(
+			const std::size_t count) {
+
+			const auto block = static_cast<unsigned char*>(
+				::operator new(count * sizeof(t) + offset, std::align_val_t(alignment)));
+
+			return reinterpret_cast<t*>(block + offset);
+
+		}
+
+		void deallocate(
+			t* const elements,
+			const std::size_t) noexcept {
+
+			::operator delete(reinterpret_cast<unsigned char*>(elements) - offset, std::align_val_t(alignment));
+
+		}
+
+		template <typename other_t>
+		bool operator==(
+			const cache_line_allocator<other_t>&) const noexcept {
+
+			return true;
+
+		}
+
+		template <typename other_t>
+		bool operator!=(
+			const cache_line_allocator<other_t>&) const noexcept {
+
+			return false;
+
+		}
+
+	};
+
+}
+
+namespace {
+
+	// An immutable copy of a red_black_tree laid out in one array in Eytzinger order: the root first,
+	// then every level from left to right, so that the children of position k sit at 2k and 2k + 1
+	/*
+				  d
+				/   \
+			   b     f		->		[ d  b  f  a  c  e  g ]
+			  / \   / \
+			 a   c e   g
+	*/
+	// A descent reads the array front to back and the levels below a position share cache lines,
+	// which lets them be prefetched before the comparison deciding between them
+	template <typename t, typename compare = std::less<t>>
+	struct frozen_red_black_tree {
+
+		using compare_type = compare;
+
+		// Position k of the layout, counting from 1, is stored at index k - 1, aligned to cache lines
+		// as described by cache_line_allocator
+		std::vector<t, utils::cache_line_allocator<t>> elements;
+
+		// Orders the payloads, an instance of std::less<t> unless specified otherwise
+		compare comparator;
+
+		frozen_red_black_tree() :
+
+			elements(),
+			comparator() {}
+
+		explicit frozen_red_black_tree(
+			const compare& comparator) :
+
+			elements(),
+			comparator(comparator) {}
+
+		// Copy constructor
+		frozen_red_black_tree(
+			const frozen_red_black_tree& other) = default;
+
+		// Move constructor
+		frozen_red_black_tree(
+			frozen_red_black_tree&& other) = default;
+
+		// Copy assignment
+		frozen_red_black_tree& operator=(
+			const frozen_red_black_tree& other) = default;
+
+		// Move assignment
+		frozen_red_black_tree& operator=(
+			frozen_red_black_tree&& other) = default;
+
+	};
+
+}
+
+namespace utils {
+
+	// Positions this many at once share a cache line, the descent prefetches that many levels ahead
+	template <typename t>
+	constexpr std::size_t prefetch_stride = sizeof(t) < cache_line_bytes ? cache_line_bytes / sizeof(t) : 1;
+
+	inline std::size_t count_trailing_ones(
+		const std::size_t value) noexcept {
+
+		// Number of consecutive set bits at the bottom of value, which must not have every bit set
+
+		const auto inverted = ~value;
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+		unsigned long index = 0;
+		_BitScanForward64(&index, static_cast<unsigned long long>(inverted));
+		return index;
+#elif defined(_MSC_VER)
+		unsigned long index = 0;
+		_BitScanForward(&index, static_cast<unsigned long>(inverted));
+		return index;
+#elif defined(__GNUC__) || defined(__clang__)
+		return static_cast<std::size_t>(__builtin_ctzll(static_cast<unsigned long long>(inverted)));
+#else
+		std::size_t count = 0;
+
+		while ((value >> count) & 1) {
+			++count;
+		}
+
+		return count;
+#endif
+
+	}
+
+	template <typename t, typename iterator>
+	void fill_eytzinger(
+		std::vector<const t*>& slots,
+		iterator& current,
+		const std::size_t position) {
+
+		// Visits the positions in order, handing each the next payload of the sorted range
+
+		if (position > slots.size()) return;
+
+		fill_eytzinger<t>(slots, current, 2 * position);
+
+		slots[position - 1] = &*current;
+		++current;
+
+		fill_eytzinger<t>(slots, current, 2 * position + 1);
+
+	}
+
+	template <typename t, typename compare, typename key_t>
+	const t* eytzinger_lower_bound(
+		const key_t& key,
+		const frozen_red_black_tree<t, compare>& tree) {
+
+		// Descends without branching on the comparisons: every step goes to 2k or 2k + 1, the outcome
+		// becoming the lowest bit of the position
+		// The path ends below a leaf, its last left turn led to the lower bound, after which the path
+		// only turned right; dropping those right turns, and the left turn itself, leads back to it
+
+		const auto count = tree.elements.size();
+		const auto elements = tree.elements.data();
+
+		std::size_t position = 1;
+
+		while (position <= count) {
+
+			// Fetch the line holding the descendants a few levels below, clamped to stay inside the array
+			prefetch(elements + std::min(position * prefetch_stride<t>, count) - 1);
+
+			position = 2 * position + static_cast<std::size_t>(tree.comparator(elements[position - 1], key));
+
+		}
+
+		// Strip the trailing right turns and the left turn before them in one shift
+		position >>= count_trailing_ones(position) + 1;
+
+		return position ? elements + position - 1 : nullptr;
+
+	}
+
+}
+
+namespace {
+
+	template <typename t, typename... options>
+	auto freeze(
+		const red_black_tree<t, options...>& tree) {
+
+		// Copies the payloads into a read only frozen_red_black_tree in linear time
+		// A multiset keeps every distinct payload once
+
+		using frozen_type = frozen_red_black_tree<t, typename red_black_tree<t, options...>::compare_type>;
+
+		frozen_type frozen(tree.comparator);
+
+
+		// Assign every payload its position //
+
+		std::vector<const t*> slots(static_cast<std::size_t>(std::distance(tree.begin(), tree.end())));
+
+		auto current = tree.begin();
+
+		utils::fill_eytzinger<t>(slots, current, 1);
+
+
+		// Copy the payloads in the order of their positions //
+
+		frozen.elements.reserve(slots.size());
+
+		for (const auto slot : slots) {
+			frozen.elements.push_back(*slot);
+		}
+
+		return frozen;
+
+	}
+
+	template <typename t, typename compare>
+	const t* lower_bound(
+		const t& data,
+		const frozen_red_black_tree<t, compare>& tree) {
+
+		// The first payload not ordered before data, nullptr if there is none
+
+		return utils::eytzinger_lower_bound<t>(data, tree);
+
+	}
+
+	template <typename t, typename compare, typename key_t,
+		typename = std::enable_if_t<utils::is_transparent<compare>::value>>
+	const t* lower_bound(
+		const key_t& key,
+		const frozen_red_black_tree<t, compare>& tree) {
+
+		return utils::eytzinger_lower_bound<t>(key, tree);
+
+	}
+
+	template <typename t, typename compare>
+	bool find(
+		const t& data,
+		const frozen_red_black_tree<t, compare>& tree) {
+
+		const auto candidate = utils::eytzinger_lower_bound<t>(data, tree);
+
+		return candidate && !tree.comparator(data, *candidate);
+
+	}
+
+	template <typename t, typename compare, typename key_t,
+		typename = std::enable_if_t<utils::is_transparent<compare>::value>>
+	bool find(
+		const key_t& key,
+		const frozen_red_black_tree<t, compare>& tree) {
+
+		const auto candidate = utils::eytzinger_lower_bound<t>(key, tree);
+
+		return candidate && !tree.comparator(key, *candidate);
+
+	}
+
+	template <typename t, typename compare>
+	std::size_t size(
+		const frozen_red_black_tree<t, compare>& tree) noexcept {
+
+		return tree.elements.size();
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "red_black_tree.h"
+#include "traversal.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+	// A closed interval [low, high]
+	template <typename point>
+	struct interval {
+
+		point low;
+		point high;
+
+		bool operator<(
+			const interval& other) const {
+
+			if (this->low < other.low) return true;
+			if (other.low < this->low) return false;
+
+			return this->high < other.high;
+
+		}
+
+		bool operator==(
+			const interval& other) const {
+
+			return !(*this < other) && !(other < *this);
+
+		}
+
+	};
+
+	// Folds the greatest high endpoint of a subtree
+	template <typename point>
+	struct max_endpoint {
+
+		static_assert(std::numeric_limits<point>::is_specialized,
+			"The endpoints need a lowest value to serve as the identity");
+
+		using value_type = point;
+
+		static value_type identity() {
+
+			return std::numeric_limits<point>::lowest();
+
+		}
+
+		static value_type lift(
+			const interval<point>& data) {
+
+			return data.high;
+
+		}
+
+		static value_type combine(
+			const value_type& a,
+			const value_type& b) {
+
+			return (std::max)(a, b);
+
+		}
+
+	};
+
+	// Intervals ordered by their low endpoint, each node knowing the greatest high endpoint below it
+	template <typename point>
+	using interval_tree = red_black_tree<interval<point>, std::less<interval<point>>, aggregate<max_endpoint<point>>>;
+
+}
+
+namespace utils {
+
+	template <typename point, typename visitor>
+	bool visit_overlapping(
+		const tree_node<interval<point>>* const node,
+		const point& low,
+		const point& high,
+		visitor& process) {
+
+		using node_type = typename interval_tree<point>::node_type;
+
+		// Nothing below ends at or after low //
+
+		if (!node || static_cast<const node_type*>(node)->subtree_aggregate < low) {
+			return true;
+		}
+
+
+		// Search the left subtree, then the node itself //
+
+		if (!visit_overlapping(node->left.get(), low, high, process)) {
+			return false;
+		}
+
+		// Every interval to the right starts after this one, so past high nothing overlaps
+		if (high < node->data.low) {
+			return true;
+		}
+
+		if (!(node->data.high < low) && !visit(process, node->data)) {
+			return false;
+		}
+
+
+		// Search the right subtree //
+
+		return visit_overlapping(node->right.get(), low, high, process);
+
+	}
+
+}
+
+namespace {
+
+	template <typename point, typename visitor>
+	bool for_each_overlapping(
+		const point& low,
+		const point& high,
+		const interval_tree<point>& tree,
+		visitor&& process) {
+
+		// Visits every interval overlapping [low, high] ordered by low endpoint
+		// Subtrees ending before low or starting after high are skipped, so k results cost
+		// O(min(n, (k + 1) log n)) and usually close to O(log n + k)
+
+		return utils::visit_overlapping<point>(tree.root, low, high, process);
+
+	}
+
+	template <typename point, typename visitor>
+	bool for_each_containing(
+		const point& at,
+		const interval_tree<point>& tree,
+		visitor&& process) {
+
+		// Visits every interval containing the given point, a stabbing query
+
+		return utils::visit_overlapping<point>(tree.root, at, at, process);
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "node_pool.h"
+
+#include <memory>
+#include <utility>
+
+namespace {
+
+	// Owns a node that was extracted from a tree, along with the pool its memory belongs to
+	// The node can be linked into a tree sharing that pool again without allocating or copying its payload,
+	// any other tree moves the payload into a node of its own
+	// A handle that is dropped hands its node back to the pool
+	template <typename t, typename node_t>
+	struct node_handle {
+
+		std::shared_ptr<node_pool<node_t>> pool;
+		node_t* node;
+
+		node_handle() noexcept :
+
+			pool(),
+			node(nullptr) {}
+
+		node_handle(
+			std::shared_ptr<node_pool<node_t>> pool,
+			node_t* const node) noexcept :
+
+			pool(std::move(pool)),
+			node(node) {}
+
+		// Copy constructor
+		node_handle(
+			const node_handle& other) = delete;
+
+		// Move constructor
+		node_handle(
+			node_handle&& other) noexcept :
+
+			pool(std::move(other.pool)),
+			node(other.node) {
+
+			other.node = nullptr;
+
+		}
+
+		// Destructor
+		~node_handle() {
+
+			if (this->node) this->pool->deallocate(this->node);
+
+		}
+
+		// Copy assignment
+		node_handle& operator=(
+			const node_handle& other) = delete;
+
+		// Move assignment
+		node_handle& operator=(
+			node_handle&& other) noexcept {
+
+			if (this == &other) return *this;
+
+			if (this->node) this->pool->deallocate(this->node);
+
+			this->pool = std::move(other.pool);
+			this->node = other.node;
+
+			other.node = nullptr;
+
+			return *this;
+
+		}
+
+		bool empty() const noexcept {
+
+			return !this->node;
+
+		}
+
+		explicit operator bool() const noexcept {
+
+			return this->node != nullptr;
+
+		}
+
+		// The payload may be changed freely while the node is out of any tree, e.g. to re-key it
+		t& value() const noexcept {
+
+			return this->node->data;
+
+		}
+
+		// Gives up ownership of the node without releasing it
+		node_t* release() noexcept {
+
+			const auto node = this->node;
+			this->node = nullptr;
+
+			return node;
+
+		}
+
+	};
+
+}
\ No newline at end of file
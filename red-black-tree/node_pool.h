@@ -0,0 +1,350 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace {
+
+	template <typename node_t>
+	struct node_pool {
+
+		union slot;
+
+		// Consecutive free slots, described in the first of them
+		struct run {
+
+			slot* next;
+			std::size_t count;
+
+		};
+
+		// A slot either holds a live node or starts a run of free slots
+		union slot {
+
+			run free;
+			alignas(node_t) unsigned char storage[sizeof(node_t)];
+
+		};
+
+		// Size of a single chunk, chosen so that a chunk spans a handful of pages
+		static constexpr std::size_t chunk_bytes = 64 * 1024;
+
+		static constexpr std::size_t chunk_capacity =
+			sizeof(slot) < chunk_bytes ? chunk_bytes / sizeof(slot) : 1;
+
+		struct chunk {
+
+			chunk* next;
+			slot slots[chunk_capacity];
+
+		};
+
+		// Singly linked list of every chunk owned by the pool, newest first
+		chunk* chunks;
+		chunk* oldest_chunk;
+
+		// Intrusive list of runs of recycled slots, the tail is only meaningful while the list is not empty
+		slot* free_list;
+		slot* free_tail;
+
+		// Number of slots of the newest chunk that have been handed out
+		std::size_t chunk_used;
+
+		// Chunks taken back by reset, handed out again before new ones are allocated
+		// The tail is only meaningful while the list is not empty
+		chunk* spare_chunks;
+		chunk* spare_tail;
+
+		// Set once the pool handed its memory over to another pool, every request is forwarded there
+		std::shared_ptr<node_pool> successor;
+
+		node_pool() noexcept :
+
+			chunks(nullptr),
+			oldest_chunk(nullptr),
+			free_list(nullptr),
+			free_tail(nullptr),
+			chunk_used(chunk_capacity),
+			spare_chunks(nullptr),
+			spare_tail(nullptr) {}
+
+		// Copy constructor
+		node_pool(
+			const node_pool& other) = delete;
+
+		// Move constructor
+		node_pool(
+			node_pool&& other) = delete;
+
+		// Destructor
+		// Releases every chunk in bulk, nodes still alive are not destructed
+		~node_pool() noexcept {
+
+			for (auto list : { this->chunks, this->spare_chunks }) {
+
+				while (list) {
+
+					auto next = list->next;
+					delete list;
+					list = next;
+
+				}
+
+			}
+
+		}
+
+		// Copy assignment
+		node_pool& operator=(
+			const node_pool& other) = delete;
+
+		// Move assignment
+		node_pool& operator=(
+			node_pool&& other) = delete;
+
+		template <typename... args>
+		node_t* allocate(
+			args&&... arguments) {
+
+			if (this->successor) return this->resolve()->allocate(std::forward<args>(arguments)...);
+
+
+			// Take a slot, preferring recycled ones //
+
+			slot* target = nullptr;
+
+			if (this->free_list) {
+
+				// Hand out the last slot of the first run, dropping the run once it is used up
+				const auto first = this->free_list;
+
+				if (first->free.count == 1) {
+
+					target = first;
+					this->free_list = first->free.next;
+
+				}
+
+				else target = first + --first->free.count;
+
+			}
+
+			else {
+
+				if (this->chunk_used == chunk_capacity) {
+
+					chunk* new_chunk = nullptr;
+
+					if (this->spare_chunks) {
+
+						new_chunk = this->spare_chunks;
+						this->spare_chunks = new_chunk->next;
+
+					}
+
+					else {
+						new_chunk = new chunk;
+					}
+
+					new_chunk->next = this->chunks;
+
+					if (!this->chunks) this->oldest_chunk = new_chunk;
+
+					this->chunks = new_chunk;
+					this->chunk_used = 0;
+
+				}
+
+				target = &this->chunks->slots[this->chunk_used++];
+
+			}
+
+
+			// Construct the node inside the slot //
+
+			try {
+				return ::new (static_cast<void*>(target->storage)) node_t(std::forward<args>(arguments)...);
+			}
+
+			catch (...) {
+
+				// Give the slot back if the payload failed to construct
+				this->push_free(target);
+
+				throw;
+
+			}
+
+		}
+
+		void deallocate(
+			node_t* const node) noexcept {
+
+			if (!node) return;
+
+			if (this->successor) {
+
+				this->resolve()->deallocate(node);
+				return;
+
+			}
+
+			node->~node_t();
+
+			this->push_free(reinterpret_cast<slot*>(node));
+
+		}
+
+		// Takes every slot back at once, keeping the chunks for the allocations to come
+		// Nodes still alive are not destructed, so this only suits trivially destructible nodes
+		void reset() noexcept {
+
+			if (this->successor) return;
+
+			if (this->chunks) {
+
+				if (!this->spare_chunks) this->spare_tail = this->oldest_chunk;
+
+				this->oldest_chunk->next = this->spare_chunks;
+				this->spare_chunks = this->chunks;
+
+			}
+
+			this->chunks = nullptr;
+			this->oldest_chunk = nullptr;
+			this->free_list = nullptr;
+			this->free_tail = nullptr;
+			this->chunk_used = chunk_capacity;
+
+		}
+
+		// Follows the chain of successors to the pool that currently owns the memory
+		// Every pool on the way is pointed straight at it, so later lookups take a single step
+		node_pool* resolve() noexcept {
+
+			if (!this->successor) return this;
+
+			auto owner = this->successor;
+
+			while (owner->successor) owner = owner->successor;
+
+			// Repointing a pool may drop the last reference to the next one, so that one is held on to
+			std::shared_ptr<node_pool> next;
+
+			auto pool = this;
+
+			while (pool->successor != owner) {
+
+				auto successor = std::move(pool->successor);
+				pool->successor = owner;
+
+				next = std::move(successor);
+				pool = next.get();
+
+			}
+
+			return owner.get();
+
+		}
+
+		// The pool that currently owns the memory, found without changing the chain, so that it can be
+		// asked about pools other threads may be using
+		const node_pool* owner() const noexcept {
+
+			auto pool = this;
+
+			while (pool->successor) pool = pool->successor.get();
+
+			return pool;
+
+		}
+
+		// Hands every chunk and recycled slot of source over to target, so nodes of both pools may be
+		// mixed freely; source forwards to target from then on and keeps it alive
+		// Apart from resolving both pools this takes constant time
+		static void merge(
+			std::shared_ptr<node_pool> target,
+			std::shared_ptr<node_pool> source) {
+
+			if (target->resolve() != target.get()) target = target->successor;
+			if (source->resolve() != source.get()) source = source->successor;
+
+			if (target == source) return;
+
+
+			// Recycle the slots source never handed out, as a single run //
+
+			if (source->chunks && source->chunk_used < chunk_capacity) {
+				source->push_free(&source->chunks->slots[source->chunk_used], chunk_capacity - source->chunk_used);
+			}
+
+
+			// Append the chunks of source //
+
+			if (source->chunks) {
+
+				if (target->chunks) target->oldest_chunk->next = source->chunks;
+				else {
+
+					target->chunks = source->chunks;
+					target->chunk_used = chunk_capacity;
+
+				}
+
+				target->oldest_chunk = source->oldest_chunk;
+
+			}
+
+
+			// Append the spare chunks of source //
+
+			if (source->spare_chunks) {
+
+				if (!target->spare_chunks) target->spare_tail = source->spare_tail;
+
+				source->spare_tail->next = target->spare_chunks;
+				target->spare_chunks = source->spare_chunks;
+
+			}
+
+
+			// Append the free list of source //
+
+			if (source->free_list) {
+
+				if (target->free_list) target->free_tail->free.next = source->free_list;
+				else target->free_list = source->free_list;
+
+				target->free_tail = source->free_tail;
+
+			}
+
+			source->chunks = nullptr;
+			source->oldest_chunk = nullptr;
+			source->free_list = nullptr;
+			source->free_tail = nullptr;
+			source->chunk_used = chunk_capacity;
+			source->spare_chunks = nullptr;
+			source->spare_tail = nullptr;
+			source->successor = std::move(target);
+
+		}
+
+		void push_free(
+			slot* const target,
+			const std::size_t count = 1) noexcept {
+
+			if (!this->free_list) this->free_tail = target;
+
+			target->free.next = this->free_list;
+			target->free.count = count;
+			this->free_list = target;
+
+		}
+
+	};
+
+}
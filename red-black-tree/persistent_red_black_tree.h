@@ -0,0 +1,535 @@
+#pragma once
+
+#include "red_black_node.h"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+	// An immutable node, shared by every version of a persistent tree that contains it
+	template <typename t>
+	struct persistent_node {
+
+		using pointer = std::shared_ptr<const persistent_node>;
+
+		t data;
+		color node_color;
+		pointer left;
+		pointer right;
+
+		persistent_node(
+			const color node_color,
+			pointer left,
+			const t& data,
+			pointer right) :
+
+			data(data),
+			node_color(node_color),
+			left(std::move(left)),
+			right(std::move(right)) {}
+
+	};
+
+	template <typename t>
+	struct persistent_tree_iterator {
+
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = t;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const t*;
+		using reference = const t&;
+
+		// Nodes whose payload and right subtree are still ahead, the next one on top
+		// Nodes carry no parent pointers, as they are shared between versions
+		std::vector<const persistent_node<t>*> pending;
+
+		persistent_tree_iterator() = default;
+
+		explicit persistent_tree_iterator(
+			const persistent_node<t>* root) {
+
+			this->descend(root);
+
+		}
+
+		reference operator*() const {
+
+			return this->pending.back()->data;
+
+		}
+
+		pointer operator->() const {
+
+			return &this->pending.back()->data;
+
+		}
+
+		persistent_tree_iterator& operator++() {
+
+			const auto node = this->pending.back();
+			this->pending.pop_back();
+
+			this->descend(node->right.get());
+
+			return *this;
+
+		}
+
+		persistent_tree_iterator operator++(int) {
+
+			auto previous = *this;
+			++(*this);
+
+			return previous;
+
+		}
+
+		bool operator==(
+			const persistent_tree_iterator& other) const {
+
+			if (this->pending.empty() || other.pending.empty()) {
+				return this->pending.empty() == other.pending.empty();
+			}
+
+			return this->pending.back() == other.pending.back();
+
+		}
+
+		bool operator!=(
+			const persistent_tree_iterator& other) const {
+
+			return !(*this == other);
+
+		}
+
+		void descend(
+			const persistent_node<t>* node) {
+
+			for (; node; node = node->left.get()) {
+				this->pending.push_back(node);
+			}
+
+		}
+
+	};
+
+	// A red-black tree whose insert and remove copy the O(log n) nodes on the search path and share the rest
+	// Copying the tree takes an O(1) snapshot that later changes to either copy leave untouched
+	template <typename t, typename compare = std::less<t>>
+	struct persistent_red_black_tree {
+
+		using compare_type = compare;
+		using node_type = persistent_node<t>;
+		using iterator = persistent_tree_iterator<t>;
+
+		std::shared_ptr<const node_type> root;
+
+		// Orders the payloads, an instance of std::less<t> unless specified otherwise
+		compare comparator;
+
+		// Number of payloads in the tree
+		std::size_t element_count;
+
+		persistent_red_black_tree() :
+
+			root(),
+			comparator(),
+			element_count(0) {}
+
+		explicit persistent_red_black_tree(
+			const compare& comparator) :
+
+			root(),
+			comparator(comparator),
+			element_count(0) {}
+
+		// Copy constructor
+		// Shares every node with other
+		persistent_red_black_tree(
+			const persistent_red_black_tree& other) = default;
+
+		// Move constructor
+		persistent_red_black_tree(
+			persistent_red_black_tree&& other) = default;
+
+		// Copy assignment
+		persistent_red_black_tree& operator=(
+			const persistent_red_black_tree& other) = default;
+
+		// Move assignment
+		persistent_red_black_tree& operator=(
+			persistent_red_black_tree&& other) = default;
+
+		iterator begin() const {
+
+			return iterator(this->root.get());
+
+		}
+
+		iterator end() const {
+
+			return iterator();
+
+		}
+
+	};
+
+}
+
+namespace utils {
+
+	// The functional insertion and deletion follow Kahrs, "Red-black trees with types"
+
+	template <typename t>
+	using persistent_pointer = typename persistent_node<t>::pointer;
+
+	template <typename t>
+	persistent_pointer<t> make_node(
+		const color node_color,
+		persistent_pointer<t> left,
+		const t& data,
+		persistent_pointer<t> right) {
+
+		return std::make_shared<const persistent_node<t>>(node_color, std::move(left), data, std::move(right));
+
+	}
+
+	template <typename t>
+	bool is_red(
+		const persistent_pointer<t>& node) noexcept {
+
+		// Nil nodes are always black
+		return node && node->node_color == color::red;
+
+	}
+
+	template <typename t>
+	bool is_black_node(
+		const persistent_pointer<t>& node) noexcept {
+
+		// A black node that is not nil
+		return node && node->node_color == color::black;
+
+	}
+
+	template <typename t>
+	persistent_pointer<t> with_color(
+		const persistent_pointer<t>& node,
+		const color node_color) {
+
+		if (node->node_color == node_color) return node;
+
+		return make_node<t>(node_color, node->left, node->data, node->right);
+
+	}
+
+	template <typename t>
+	persistent_pointer<t> balanced(
+		const persistent_pointer<t>& left,
+		const t& data,
+		const persistent_pointer<t>& right) {
+
+		// Builds a black node over left and right, resolving a red child with a red child of its own
+		// by turning the three involved nodes into a red node with two black children
+
+		// Both children are red
+		/*
+				  bx				rx
+				 /  \		->	   /  \
+				ra   rb			  ba   bb
+		*/
+		if (is_red<t>(left) && is_red<t>(right)) {
+			return make_node<t>(color::red, with_color<t>(left, color::black), data, with_color<t>(right, color::black));
+		}
+
+		if (is_red<t>(left)) {
+
+			if (is_red<t>(left->left)) {
+				return make_node<t>(color::red,
+					with_color<t>(left->left, color::black),
+					left->data,
+					make_node<t>(color::black, left->right, data, right));
+			}
+
+			if (is_red<t>(left->right)) {
+				return make_node<t>(color::red,
+					make_node<t>(color::black, left->left, left->data, left->right->left),
+					left->right->data,
+					make_node<t>(color::black, left->right->right, data, right));
+			}
+
+		}
+
+		if (is_red<t>(right)) {
+
+			if (is_red<t>(right->right)) {
+				return make_node<t>(color::red,
+					make_node<t>(color::black, left, data, right->left),
+					right->data,
+					with_color<t>(right->right, color::black));
+			}
+
+			if (is_red<t>(right->left)) {
+				return make_node<t>(color::red,
+					make_node<t>(color::black, left, data, right->left->left),
+					right->left->data,
+					make_node<t>(color::black, right->left->right, right->data, right->right));
+			}
+
+		}
+
+		return make_node<t>(color::black, left, data, right);
+
+	}
+
+	template <typename t>
+	persistent_pointer<t> left_balanced(
+		const persistent_pointer<t>& left,
+		const t& data,
+		const persistent_pointer<t>& right) {
+
+		// Builds a node whose left subtree lost one black node through a deletion
+
+		if (is_red<t>(left)) {
+			return make_node<t>(color::red, with_color<t>(left, color::black), data, right);
+		}
+
+		if (is_black_node<t>(right)) {
+			return balanced<t>(left, data, with_color<t>(right, color::red));
+		}
+
+		if (is_red<t>(right) && is_black_node<t>(right->left)) {
+			return make_node<t>(color::red,
+				make_node<t>(color::black, left, data, right->left->left),
+				right->left->data,
+				balanced<t>(right->left->right, right->data, with_color<t>(right->right, color::red)));
+		}
+
+		throw std::logic_error("Tree is not balanced");
+
+	}
+
+	template <typename t>
+	persistent_pointer<t> right_balanced(
+		const persistent_pointer<t>& left,
+		const t& data,
+		const persistent_pointer<t>& right) {
+
+		// Builds a node whose right subtree lost one black node through a deletion
+
+		if (is_red<t>(right)) {
+			return make_node<t>(color::red, left, data, with_color<t>(right, color::black));
+		}
+
+		if (is_black_node<t>(left)) {
+			return balanced<t>(with_color<t>(left, color::red), data, right);
+		}
+
+		if (is_red<t>(left) && is_black_node<t>(left->right)) {
+			return make_node<t>(color::red,
+				balanced<t>(with_color<t>(left->left, color::red), left->data, left->right->left),
+				left->right->data,
+				make_node<t>(color::black, left->right->right, data, right));
+		}
+
+		throw std::logic_error("Tree is not balanced");
+
+	}
+
+	template <typename t>
+	persistent_pointer<t> appended(
+		const persistent_pointer<t>& left,
+		const persistent_pointer<t>& right) {
+
+		// Fuses the two subtrees of a deleted node, every payload of left orders before those of right
+
+		if (!left) return right;
+		if (!right) return left;
+
+		if (is_red<t>(left) && is_red<t>(right)) {
+
+			const auto middle = appended<t>(left->right, right->left);
+
+			if (is_red<t>(middle)) {
+				return make_node<t>(color::red,
+					make_node<t>(color::red, left->left, left->data, middle->left),
+					middle->data,
+					make_node<t>(color::red, middle->right, right->data, right->right));
+			}
+
+			return make_node<t>(color::red,
+				left->left,
+				left->data,
+				make_node<t>(color::red, middle, right->data, right->right));
+
+		}
+
+		if (!is_red<t>(left) && !is_red<t>(right)) {
+
+			const auto middle = appended<t>(left->right, right->left);
+
+			if (is_red<t>(middle)) {
+				return make_node<t>(color::red,
+					make_node<t>(color::black, left->left, left->data, middle->left),
+					middle->data,
+					make_node<t>(color::black, middle->right, right->data, right->right));
+			}
+
+			return left_balanced<t>(left->left, left->data, make_node<t>(color::black, middle, right->data, right->right));
+
+		}
+
+		if (is_red<t>(right)) {
+			return make_node<t>(color::red, appended<t>(left, right->left), right->data, right->right);
+		}
+
+		return make_node<t>(color::red, left->left, left->data, appended<t>(left->right, right));
+
+	}
+
+	template <typename t, typename compare>
+	persistent_pointer<t> inserted(
+		const persistent_pointer<t>& node,
+		const t& data,
+		const compare& comparator) {
+
+		if (!node) {
+			return make_node<t>(color::red, nullptr, data, nullptr);
+		}
+
+		if (comparator(data, node->data)) {
+
+			if (is_red<t>(node)) {
+				return make_node<t>(color::red, inserted<t>(node->left, data, comparator), node->data, node->right);
+			}
+
+			return balanced<t>(inserted<t>(node->left, data, comparator), node->data, node->right);
+
+		}
+
+		if (comparator(node->data, data)) {
+
+			if (is_red<t>(node)) {
+				return make_node<t>(color::red, node->left, node->data, inserted<t>(node->right, data, comparator));
+			}
+
+			return balanced<t>(node->left, node->data, inserted<t>(node->right, data, comparator));
+
+		}
+
+		throw std::runtime_error("Duplicate entry not supported");
+
+	}
+
+	template <typename t, typename compare>
+	persistent_pointer<t> removed(
+		const persistent_pointer<t>& node,
+		const t& data,
+		const compare& comparator) {
+
+		if (!node) return nullptr;
+
+		if (comparator(data, node->data)) {
+
+			if (is_black_node<t>(node->left)) {
+				return left_balanced<t>(removed<t>(node->left, data, comparator), node->data, node->right);
+			}
+
+			return make_node<t>(color::red, removed<t>(node->left, data, comparator), node->data, node->right);
+
+		}
+
+		if (comparator(node->data, data)) {
+
+			if (is_black_node<t>(node->right)) {
+				return right_balanced<t>(node->left, node->data, removed<t>(node->right, data, comparator));
+			}
+
+			return make_node<t>(color::red, node->left, node->data, removed<t>(node->right, data, comparator));
+
+		}
+
+		return appended<t>(node->left, node->right);
+
+	}
+
+}
+
+namespace {
+
+	template <typename t, typename compare>
+	void insert(
+		const t& data,
+		persistent_red_black_tree<t, compare>& tree) {
+
+		// Copies the search path, snapshots taken before keep their version
+
+		tree.root = utils::with_color<t>(utils::inserted<t>(tree.root, data, tree.comparator), color::black);
+
+		++tree.element_count;
+
+	}
+
+	template <typename t, typename compare>
+	bool find(
+		const t& data,
+		const persistent_red_black_tree<t, compare>& tree) {
+
+		const persistent_node<t>* current_node = tree.root.get();
+
+		while (current_node) {
+
+			if (tree.comparator(data, current_node->data)) {
+				current_node = current_node->left.get();
+			}
+
+			else if (tree.comparator(current_node->data, data)) {
+				current_node = current_node->right.get();
+			}
+
+			else {
+				return true;
+			}
+
+		}
+
+		return false;
+
+	}
+
+	template <typename t, typename compare>
+	bool remove(
+		const t& data,
+		persistent_red_black_tree<t, compare>& tree) {
+
+		// Copies the search path, snapshots taken before keep their version
+
+		// Nothing is copied when there is nothing to remove
+		if (!find<t>(data, tree)) {
+			return false;
+		}
+
+		const auto root = utils::removed<t>(tree.root, data, tree.comparator);
+
+		tree.root = root ? utils::with_color<t>(root, color::black) : nullptr;
+
+		--tree.element_count;
+
+		return true;
+
+	}
+
+	template <typename t, typename compare>
+	std::size_t size(
+		const persistent_red_black_tree<t, compare>& tree) noexcept {
+
+		return tree.element_count;
+
+	}
+
+}
\ No newline at end of file
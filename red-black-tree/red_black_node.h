@@ -2,6 +2,10 @@
 
 #include "tree_node.h"
 
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
 namespace {
 
 	enum class color : bool {
@@ -12,50 +16,66 @@ namespace {
 	template <typename t>
 	struct red_black_node : public tree_node<t> {
 
-		color color;
-		red_black_node<t>* parent;
+		static_assert(alignof(tree_node<t>) >= 2, "The lowest bit of a node's address must be free");
+
+		static constexpr std::uintptr_t color_mask = 1;
+
+		// The parent pointer with the node's color packed into its lowest bit
+		// Nodes are at least pointer aligned, so that bit of a node's address is always zero
+		std::uintptr_t parent_and_color;
 
 		// Minimal constructor
 		red_black_node(
-			t data) noexcept :
+			const t& data) noexcept(std::is_nothrow_copy_constructible<t>::value) :
 
 			tree_node<t>(data),
-			color(color::black),
-			parent(nullptr) {}
+			parent_and_color(0) {}
+
+		// Minimal constructor taking ownership of the payload
+		red_black_node(
+			t&& data) noexcept(std::is_nothrow_move_constructible<t>::value) :
+
+			tree_node<t>(std::move(data)),
+			parent_and_color(0) {}
+
+		// In place constructor, builds the payload from the given arguments
+		template <typename... args>
+		explicit red_black_node(
+			std::in_place_t,
+			args&&... arguments) noexcept(std::is_nothrow_constructible<t, args...>::value) :
+
+			tree_node<t>(std::in_place, std::forward<args>(arguments)...),
+			parent_and_color(0) {}
 
 		// Copy constructor
 		red_black_node(
-			const red_black_node& other) noexcept :
+			const red_black_node& other) noexcept(std::is_nothrow_copy_constructible<t>::value) :
 
 			tree_node<t>(other),
-			color(other.color),
-			parent(other.parent) {}
+			parent_and_color(other.parent_and_color) {}
 
 		// Move constructor
 		red_black_node(
-			red_black_node&& other) noexcept :
+			red_black_node&& other) noexcept(std::is_nothrow_move_constructible<t>::value) :
 
 			tree_node<t>(std::move(other)),
-			color(other.color),
-			parent(other.parent) {
+			parent_and_color(other.parent_and_color) {
 
-			other.color = color::black;
-			other.parent = nullptr;
+			other.parent_and_color = 0;
 
 		}
 
 		// Destructor
-		~red_black_node() noexcept {}
+		~red_black_node() = default;
 
 		// Copy assignment
 		red_black_node& operator=(
-			const red_black_node& other) noexcept {
+			const red_black_node& other) noexcept(std::is_nothrow_copy_assignable<t>::value) {
 
 			if (this == &other) return *this;
 
 			tree_node<t>::operator=(other);
-			this->color = other.color;
-			this->parent = other.parent;
+			this->parent_and_color = other.parent_and_color;
 
 			return *this;
 
@@ -63,21 +83,45 @@ namespace {
 
 		// Move assignment
 		red_black_node& operator=(
-			red_black_node&& other) noexcept {
+			red_black_node&& other) noexcept(std::is_nothrow_move_assignable<t>::value) {
 		
 			if (this == &other) return *this;
 
 			tree_node<t>::operator=(std::move(other));
-			this->color = other.color;
-			this->parent = other.parent;
+			this->parent_and_color = other.parent_and_color;
 
-			other.color = color::black;
-			other.parent = nullptr;
+			other.parent_and_color = 0;
 
 			return *this;
 
 		}
 
+		red_black_node* get_parent() const noexcept {
+
+			return reinterpret_cast<red_black_node*>(this->parent_and_color & ~color_mask);
+
+		}
+
+		void set_parent(
+			red_black_node* const parent) noexcept {
+
+			this->parent_and_color = reinterpret_cast<std::uintptr_t>(parent) | (this->parent_and_color & color_mask);
+
+		}
+
+		color get_color() const noexcept {
+
+			return static_cast<color>(this->parent_and_color & color_mask);
+
+		}
+
+		void set_color(
+			const color color) noexcept {
+
+			this->parent_and_color = (this->parent_and_color & ~color_mask) | static_cast<std::uintptr_t>(color);
+
+		}
+
 	};
 
 }
\ No newline at end of file
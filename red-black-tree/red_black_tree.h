@@ -1,12 +1,34 @@
 #pragma once
 
+#include "augmentation.h"
+#include "node_handle.h"
+#include "node_pool.h"
 #include "red_black_node.h"
-
-#include <queue>
+#include "tree_iterator.h"
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__cpp_impl_three_way_comparison)
+#include <compare>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#endif
 
 namespace {
 
-	template <typename t>
+	template <typename t, typename compare = std::less<t>, typename augment = no_augmentation>
 	struct red_black_tree;
 
 }
@@ -20,7 +42,7 @@ namespace utils {
 		// Nil nodes are always black
 		if (!node) return color::black;
 
-		return static_cast<red_black_node<t>*>(node)->color;
+		return static_cast<red_black_node<t>*>(node)->get_color();
 
 	}
 
@@ -31,13 +53,102 @@ namespace utils {
 
 		if (!node) return;
 
-		static_cast<red_black_node<t>*>(node)->color = color;
+		static_cast<red_black_node<t>*>(node)->set_color(color);
+
+	}
+
+	template <typename t>
+	color get_color(
+		const node_link<tree_node<t>>& link) {
+
+		return get_color<t>(link.get());
 
 	}
 
 	template <typename t>
+	void set_color(
+		const node_link<tree_node<t>>& link,
+		color color) {
+
+		set_color<t>(link.get(), color);
+
+	}
+
+	template <typename t>
+	void swap_colors(
+		red_black_node<t>* const a,
+		red_black_node<t>* const b) {
+
+		const auto a_color = a->get_color();
+
+		a->set_color(b->get_color());
+		b->set_color(a_color);
+
+	}
+
+	template <typename t, typename... options>
+	void update_node(
+		red_black_tree<t, options...>&,
+		red_black_node<t>* const node) {
+
+		// Recompute the augmentation metadata of node from its payload and children
+
+		using tree_type = red_black_tree<t, options...>;
+
+		if constexpr (!std::is_same<typename tree_type::augment_type, no_augmentation>::value) {
+			tree_type::augment_type::update(static_cast<typename tree_type::node_type&>(*node));
+		}
+
+	}
+
+	template <typename t, typename... options>
+	void update_path(
+		red_black_tree<t, options...>& tree,
+		red_black_node<t>* node) {
+
+		// Recompute the augmentation metadata from node up to the root
+
+		using tree_type = red_black_tree<t, options...>;
+
+		if constexpr (!std::is_same<typename tree_type::augment_type, no_augmentation>::value) {
+
+			while (node) {
+
+				update_node<t>(tree, node);
+				node = node->get_parent();
+
+			}
+
+		}
+
+	}
+
+	template <typename t, typename... options>
+	auto& acquire_pool(
+		red_black_tree<t, options...>& tree) {
+
+		// The pool of tree, created first if tree was emptied by a move and has not needed memory since
+
+		if (!tree.pool) tree.pool = std::make_shared<node_pool<typename red_black_tree<t, options...>::node_type>>();
+
+		return tree.pool;
+
+	}
+
+	template <typename t, typename... options>
+	void release_node(
+		red_black_tree<t, options...>& tree,
+		red_black_node<t>* const node) noexcept {
+
+		// Hand a node back to the pool of its tree
+
+		tree.pool->deallocate(static_cast<typename red_black_tree<t, options...>::node_type*>(node));
+
+	}
+
+	template <typename t, typename... options>
 	void rotate_left(
-		red_black_tree<t>& tree,
+		red_black_tree<t, options...>& tree,
 		red_black_node<t>* const node) {
 
 		//	   \ /			   \ /
@@ -60,36 +171,44 @@ namespace utils {
 
 		n->right = y->left;
 		if(y->left)
-			static_cast<red_black_node<t>*>(y->left)->parent = n;
+			static_cast<red_black_node<t>*>(y->left)->set_parent(n);
 
 
 		// Connect y with the parent of n //
 
-		y->parent = n->parent;
+		const auto parent = n->get_parent();
 
-		if (n->parent == nullptr) {
+		y->set_parent(parent);
+
+		if (parent == nullptr) {
 			tree.root = y;
 		}
 
-		else if (n == n->parent->left) {
-			n->parent->left = y;
+		else if (n == parent->left) {
+			parent->left = y;
 		}
 
 		else {
-			n->parent->right = y;
+			parent->right = y;
 		}
 
 
 		// Make y the parent of n //
 
 		y->left = n;
-		n->parent = y;
+		n->set_parent(y);
+
+
+		// Refresh the metadata of the two nodes whose subtrees changed //
+
+		update_node<t>(tree, n);
+		update_node<t>(tree, y);
 
 	}
 
-	template <typename t>
+	template <typename t, typename... options>
 	void rotate_right(
-		red_black_tree<t>& tree,
+		red_black_tree<t, options...>& tree,
 		red_black_node<t>* const node) {
 
 		//	   \ /			   \ /
@@ -112,38 +231,48 @@ namespace utils {
 
 		n->left = y->right;
 		if(y->right)
-			static_cast<red_black_node<t>*>(y->right)->parent = n;
+			static_cast<red_black_node<t>*>(y->right)->set_parent(n);
 
 
 		// Connect y with the parent of n //
 
-		y->parent = n->parent;
+		const auto parent = n->get_parent();
+
+		y->set_parent(parent);
 
-		if (n->parent == nullptr) {
+		if (parent == nullptr) {
 			tree.root = y;
 		}
 
-		else if (n == n->parent->left) {
-			n->parent->left = y;
+		else if (n == parent->left) {
+			parent->left = y;
 		}
 
 		else {
-			n->parent->right = y;
+			parent->right = y;
 		}
 
 
 		// Make y the parent of n //
 
 		y->right = n;
-		n->parent = y;
+		n->set_parent(y);
+
+
+		// Refresh the metadata of the two nodes whose subtrees changed //
+
+		update_node<t>(tree, n);
+		update_node<t>(tree, y);
 
 	}
 
-	template <typename t>
-	void fix_insert(
-		red_black_tree<t>& tree,
+	template <typename t, typename... options>
+	bool fix_insert(
+		red_black_tree<t, options...>& tree,
 		red_black_node<t>* node) {
 
+		// Returns whether the black height of the tree grew, which happens when the recoloring reaches the root
+
 		// node initially is the node that was inserted into the tree
 		red_black_node<t>* parent = nullptr;
 		red_black_node<t>* grandparent = nullptr;
@@ -157,10 +286,10 @@ namespace utils {
 		//
 		while (node != tree.root &&
 			get_color(node) == color::red &&
-			get_color(node->parent) == color::red) {
+			get_color(node->get_parent()) == color::red) {
 
-			parent = node->parent;
-			grandparent = parent->parent;
+			parent = node->get_parent();
+			grandparent = parent->get_parent();
 
 			// If the parent is the left child of the grandparent
 			//
@@ -233,7 +362,7 @@ namespace utils {
 						//	rn
 						//
 						node = parent;
-						parent = node->parent;
+						parent = node->get_parent();
 
 					}
 
@@ -255,7 +384,7 @@ namespace utils {
 					//			\
 					//			bu
 					//
-					std::swap(parent->color, grandparent->color);
+					utils::swap_colors(parent, grandparent);
 
 					// Proceed to the parent and continue to the next iteration
 					node = parent;
@@ -334,7 +463,7 @@ namespace utils {
 						//			rn
 						//
 						node = parent;
-						parent = node->parent;
+						parent = node->get_parent();
 
 					}
 
@@ -356,7 +485,7 @@ namespace utils {
 					//	 /
 					//	bu
 					//
-					std::swap(parent->color, grandparent->color);
+					utils::swap_colors(parent, grandparent);
 
 					// Proceed to the parent and continue to the next iteration
 					node = parent;
@@ -368,13 +497,17 @@ namespace utils {
 		}
 
 		// Recolor the root black (it might've become red through a rotation)
+		const auto grew = get_color<t>(tree.root) == color::red;
+
 		set_color(tree.root, color::black);
 
+		return grew;
+
 	}
 
-	template <typename t>
+	template <typename t, typename... options>
 	void fix_delete(
-		red_black_tree<t>& tree,
+		red_black_tree<t, options...>& tree,
 		red_black_node<t>* node,
 		red_black_node<t>* node_parent,
 		bool node_is_left) {
@@ -441,7 +574,7 @@ namespace utils {
 
 					// Proceed to the node's parent
 					node = node_parent;
-					node_parent = node->parent;
+					node_parent = node->get_parent();
 
 					// Determine if the parent proceeded to is a left or right child
 					node_is_left = (node_parent != nullptr && node == node_parent->left);
@@ -488,7 +621,7 @@ namespace utils {
 					//  	 /  \
 					//	    bn   b0
 					//
-					set_color(uncle, node_parent->color);
+					set_color(uncle, node_parent->get_color());
 					set_color(node_parent, color::black);
 					set_color(uncle->right, color::black);
 					rotate_left(tree, node_parent);
@@ -555,7 +688,7 @@ namespace utils {
 
 					// Proceed to the node's parent
 					node = node_parent;
-					node_parent = node->parent;
+					node_parent = node->get_parent();
 
 					// Determine if the parent proceeded to is a left or right child
 					node_is_left = (node_parent != nullptr && node == node_parent->left);
@@ -602,7 +735,7 @@ namespace utils {
 					//		  /  \
 					//		 b1	  bn
 					//
-					set_color(uncle, node_parent->color);
+					set_color(uncle, node_parent->get_color());
 					set_color(node_parent, color::black);
 					set_color(uncle->left, color::black);
 					rotate_right(tree, node_parent);
@@ -624,6 +757,17 @@ namespace utils {
 
 	}
 
+	template <typename t>
+	tree_node<t>* get_minimum_node(
+		tree_node<t>* node) {
+
+		while (node->left)
+			node = node->left;
+
+		return node;
+
+	}
+
 	template <typename t>
 	tree_node<t>* get_maximum_node(
 		tree_node<t>* node) {
@@ -635,264 +779,2718 @@ namespace utils {
 
 	}
 
-}
-
-namespace {
+	inline void prefetch(
+		const void* const address) noexcept {
 
-	template <typename t>
-	struct red_black_tree {
+		// Asks for the cache line holding address to be loaded, without waiting for it
 
-		red_black_node<t>* root;
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+		_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(address);
+#else
+		static_cast<void>(address);
+#endif
 
-		red_black_tree() :
+	}
 
-			root(nullptr) {}
+	// Whether the comparator accepts keys of other types than the payload, like std::less<>
+	template <typename compare, typename = void>
+	struct is_transparent : std::false_type {};
 
-		// Copy constructor
-		red_black_tree(
-			const red_black_tree& other) = delete;
+	template <typename compare>
+	struct is_transparent<compare, std::void_t<typename compare::is_transparent>> : std::true_type {};
 
-		// Move constructor
-		red_black_tree(
-			red_black_tree&& other) = delete;
+	// Whether a key can be ordered against a payload with a single <=> instead of the comparator
+	// Only the standard less comparators are known to agree with <=>
+	template <typename compare, typename key_t, typename t, typename = void>
+	struct uses_three_way : std::false_type {};
 
-		// Destructor
-		~red_black_tree() {
+#if defined(__cpp_lib_three_way_comparison) && defined(__cpp_lib_concepts)
 
-			if (!this->root) return;
+	template <typename compare, typename key_t, typename t>
+	struct uses_three_way<compare, key_t, t, std::enable_if_t<
+		(std::is_same<compare, std::less<t>>::value || std::is_same<compare, std::less<>>::value) &&
+		std::three_way_comparable_with<key_t, t>>> : std::true_type {};
 
-			// Level order traversal 
-			std::queue<red_black_node<t>*> node_queue;
-			node_queue.push(this->root);
+#endif
 
-			while (!node_queue.empty()) {
+	template <typename compare, typename key_t, typename t>
+	int compare_three_way(
+		const compare& comparator,
+		const key_t& key,
+		const t& data) {
 
-				auto current_node = node_queue.front();
-				node_queue.pop();
+		// Negative if key orders before data, positive if after, zero if equivalent
 
-				if (current_node->left != nullptr)
-					node_queue.push(static_cast<red_black_node<t>*>(current_node->left));
+#if defined(__cpp_lib_three_way_comparison) && defined(__cpp_lib_concepts)
 
-				if (current_node->right != nullptr)
-					node_queue.push(static_cast<red_black_node<t>*>(current_node->right));
+		if constexpr (uses_three_way<compare, key_t, t>::value) {
 
-				delete current_node;
+			const auto order = key <=> data;
 
-			}
+			return order < 0 ? -1 : (order > 0 ? 1 : 0);
 
 		}
 
-		// Copy assignment
-		red_black_tree& operator=(
-			const red_black_tree& other) = delete;
+		else
 
-		// Move assignment
-		red_black_tree& operator=(
-			red_black_tree&& other) = delete;
+#endif
 
-	};
+		return comparator(key, data) ? -1 : (comparator(data, key) ? 1 : 0);
 
-	template <typename t>
-	void insert(
-		const t data,
-		red_black_tree<t>& tree) {
+	}
 
-		// If tree empty, insert first node //
+	template <typename t, typename... options, typename key_t>
+	red_black_node<t>* find_node(
+		const key_t& key,
+		const red_black_tree<t, options...>& tree) {
 
-		if (!tree.root) {
-			tree.root = new red_black_node<t>(data);
-			return;
-		}
+		using compare = typename red_black_tree<t, options...>::compare_type;
 
+		auto current_node = tree.root;
 
-		// Find a parent leaf node for the new node //
+		// A three-way comparison tells all outcomes apart at once //
 
-		tree_node<t>* current_node = tree.root;
-		tree_node<t>* parent = nullptr;
+		if constexpr (uses_three_way<compare, key_t, t>::value) {
 
-		while (current_node) {
+			while (current_node) {
 
-			parent = current_node;
+				const auto order = compare_three_way(tree.comparator, key, current_node->data);
+
+				if (order < 0) {
+					current_node = static_cast<red_black_node<t>*>(current_node->left);
+				}
+
+				else if (order > 0) {
+					current_node = static_cast<red_black_node<t>*>(current_node->right);
+				}
+
+				else {
+					return current_node;
+				}
 
-			if (data < current_node->data) {
-				current_node = current_node->left;
 			}
 
-			else if (data > current_node->data) {
-				current_node = current_node->right;
+			return nullptr;
+
+		}
+
+		// Otherwise descend with a single comparison per level //
+
+		else {
+
+			// The last node the descent turned right at is the greatest one not ordered after key
+			red_black_node<t>* candidate = nullptr;
+
+			while (current_node) {
+
+				if (tree.comparator(key, current_node->data)) {
+					current_node = static_cast<red_black_node<t>*>(current_node->left);
+				}
+
+				else {
+					candidate = current_node;
+					current_node = static_cast<red_black_node<t>*>(current_node->right);
+				}
+
 			}
 
-			else {
-				throw std::runtime_error("Duplicate entry not supported");
+			// Only that node can hold a key equivalent to key
+			if (candidate && !tree.comparator(candidate->data, key)) {
+				return candidate;
 			}
 
+			return nullptr;
+
 		}
 
+	}
 
-		// Add a new node to the leaf //
+	// Number of descents find_batch interleaves, enough to keep a few cache misses in flight each
+	constexpr std::size_t batch_group_size = 16;
 
-		auto new_node = new red_black_node<t>(data);
-		new_node->color = color::red;
+	template <typename t, typename... options, typename key_t>
+	void find_group(
+		const std::vector<key_t>& keys,
+		const std::size_t first,
+		const std::size_t last,
+		std::vector<bool>& results,
+		const red_black_tree<t, options...>& tree) {
 
-		if (data < parent->data) {
-			parent->left = new_node;
-		}
+		// Descends for keys[first] up to keys[last] in lockstep, one level of every descent at a time
+		// The next node of a descent is prefetched right away and only read once the other descents took
+		// their step, so the misses of the whole group overlap instead of following each other
+		//
+		//		key 0:	r -> a -> c -> ...
+		//		key 1:	r -> b -> e -> ...		level by level, each arrow a prefetch
+		//		key 2:	r -> a -> d -> ...
+		//
+
+		const tree_node<t>* current[batch_group_size];
+		const tree_node<t>* candidate[batch_group_size];
+
+		const auto lanes = last - first;
+
+		for (std::size_t lane = 0; lane < lanes; ++lane) {
+
+			current[lane] = tree.root;
+			candidate[lane] = nullptr;
 
-		else {
-			parent->right = new_node;
 		}
 
-		new_node->parent = static_cast<red_black_node<t>*>(parent);
 
+		// Take one step of every unfinished descent per round //
 
-		// Rebalance the tree if necessary //
+		auto active = tree.root != nullptr;
 
-		utils::fix_insert<t>(tree, new_node);
+		while (active) {
 
-	}
+			active = false;
 
-	template <typename t>
-	bool remove(
-		const t data,
-		red_black_tree<t>& tree) {
+			for (std::size_t lane = 0; lane < lanes; ++lane) {
 
-		// Find the node to remove //
+				const auto node = current[lane];
 
-		auto target_node = tree.root;
+				if (!node) continue;
 
-		while (target_node) {
+				// Like find_node, the last node the descent turned right at is the only possible match
+				if (tree.comparator(keys[first + lane], node->data)) {
+					current[lane] = node->left;
+				}
+
+				else {
+					candidate[lane] = node;
+					current[lane] = node->right;
+				}
+
+				if (current[lane]) {
+
+					prefetch(current[lane]);
+					active = true;
+
+				}
 
-			if (data < target_node->data) {
-				target_node = static_cast<red_black_node<t>*>(target_node->left);
 			}
 
-			else if (data > target_node->data) {
-				target_node = static_cast<red_black_node<t>*>(target_node->right);
+		}
+
+
+		// Check the candidates //
+
+		for (std::size_t lane = 0; lane < lanes; ++lane) {
+			results[first + lane] = candidate[lane] && !tree.comparator(candidate[lane]->data, keys[first + lane]);
+		}
+
+	}
+
+	template <typename t, typename... options, typename key_t>
+	red_black_node<t>* lower_bound_node(
+		const key_t& key,
+		const red_black_tree<t, options...>& tree) {
+
+		// Find the first node not ordered before key, nullptr if there is none
+
+		red_black_node<t>* current_node = tree.root;
+		red_black_node<t>* result = nullptr;
+
+		while (current_node) {
+
+			if (!tree.comparator(current_node->data, key)) {
+				result = current_node;
+				current_node = static_cast<red_black_node<t>*>(current_node->left);
 			}
 
 			else {
-				break;
+				current_node = static_cast<red_black_node<t>*>(current_node->right);
 			}
 
 		}
 
-		if (!target_node) {
-			return false;
-		}
+		return result;
 
+	}
 
-		// Select a node to delete //
+	template <typename t, typename... options, typename key_t>
+	red_black_node<t>* upper_bound_node(
+		const key_t& key,
+		const red_black_tree<t, options...>& tree) {
 
-		red_black_node<t>* to_be_deleted = nullptr;
+		// Find the first node ordered after key, nullptr if there is none
 
-		// If the target node has at most 1 child
-		if (!target_node->left || !target_node->right) {
+		red_black_node<t>* current_node = tree.root;
+		red_black_node<t>* result = nullptr;
 
-			// Mark the target_node for deletion
-			to_be_deleted = target_node;
+		while (current_node) {
+
+			if (tree.comparator(key, current_node->data)) {
+				result = current_node;
+				current_node = static_cast<red_black_node<t>*>(current_node->left);
+			}
+
+			else {
+				current_node = static_cast<red_black_node<t>*>(current_node->right);
+			}
 
 		}
 
-		// If the target node has two children
-		else {
+		return result;
 
-			// Mark the left tree's max node for deletion
-			to_be_deleted = static_cast<red_black_node<t>*>(utils::get_maximum_node(target_node->left));
+	}
 
-		}
+	template <typename t, typename... options>
+	red_black_node<t>* find_insert_parent(
+		const t& data,
+		const red_black_tree<t, options...>& tree,
+		bool& is_left,
+		red_black_node<t>*& existing) {
 
+		// Find a parent leaf node for a new node holding data
+		// An empty tree has no parent leaf, nullptr is returned instead
+		// If a payload equivalent to data is present, its node is stored in existing and nullptr returned
 
-		// Get a handle to the child of the node to delete //
+		existing = nullptr;
 
-		auto child = to_be_deleted->left ?
-			static_cast<red_black_node<t>*>(to_be_deleted->left) :
-			static_cast<red_black_node<t>*>(to_be_deleted->right);
+		using compare = typename red_black_tree<t, options...>::compare_type;
 
 
-		// Connect the child to it's grandparent //
+		// Payloads past the largest one are appended without a descent //
+
+		if (tree.rightmost && tree.comparator(tree.rightmost->data, data)) {
+
+			is_left = false;
+			return tree.rightmost;
 
-		// Set the child's parent to it's grandparent
-		if (child) {
-			child->parent = to_be_deleted->parent;
 		}
 
-		bool child_is_left = false;
+		tree_node<t>* current_node = tree.root;
+		tree_node<t>* parent = nullptr;
 
-		// If the node to be deleted is the root node
-		if (!to_be_deleted->parent) {
+		// A three-way comparison tells all outcomes apart at once //
 
-			// Let the child be the new root
-			tree.root = child;
+		if constexpr (uses_three_way<compare, t, t>::value) {
 
-		}
+			while (current_node) {
 
-		// If the node to be deleted is it's parent's left child
-		else if (to_be_deleted == to_be_deleted->parent->left) {
+				parent = current_node;
 
-			// Set the parent's left child to child
-			to_be_deleted->parent->left = child;
-			child_is_left = true;
+				const auto order = compare_three_way(tree.comparator, data, current_node->data);
 
-		}
+				if (order == 0) {
 
-		// If the node to be deleted is it's parent's right child
-		else if(to_be_deleted == to_be_deleted->parent->right) {
+					existing = static_cast<red_black_node<t>*>(current_node);
+					return nullptr;
 
-			// Set the parent's right child to child
-			to_be_deleted->parent->right = child;
-			child_is_left = false;
+				}
+
+				is_left = order < 0;
+				current_node = is_left ? current_node->left : current_node->right;
+
+			}
 
 		}
 
+		// Otherwise descend with a single comparison per level //
 
-		// Transfer payload to the target node //
+		else {
 
-		if (to_be_deleted != target_node) {
-			target_node->data = to_be_deleted->data;
-		}
+			// The last node the descent turned right at is the greatest one not ordered after data
+			tree_node<t>* candidate = nullptr;
 
+			while (current_node) {
 
-		// Rebalance //
+				parent = current_node;
+				is_left = tree.comparator(data, current_node->data);
 
-		const auto child_parent = to_be_deleted->parent;
+				if (is_left) {
+					current_node = current_node->left;
+				}
 
-		if (utils::get_color(to_be_deleted) == color::black && child_parent) {
-			utils::fix_delete<t>(tree, child, child_parent, child_is_left);
-		}
+				else {
+					candidate = current_node;
+					current_node = current_node->right;
+				}
 
+			}
 
-		// Release memory //
+			// Only that node can hold a payload equivalent to data
+			if (candidate && !tree.comparator(candidate->data, data)) {
 
-		delete to_be_deleted;
+				existing = static_cast<red_black_node<t>*>(candidate);
+				return nullptr;
 
-		return true;
+			}
+
+		}
+
+		return static_cast<red_black_node<t>*>(parent);
 
 	}
 
-	template <typename t>
-	bool find(
-		const t data,
-		red_black_tree<t>& tree) {
+	template <typename t, typename... options>
+	red_black_node<t>* find_hinted_parent(
+		const typename red_black_tree<t, options...>::iterator hint,
+		const t& data,
+		const red_black_tree<t, options...>& tree,
+		bool& is_left,
+		red_black_node<t>*& existing) {
 
-		tree_node<t>* current_node = tree.root;
+		// Like find_insert_parent, but first checks whether data belongs right before hint, in which case
+		// the new node hangs below hint or its in order predecessor without a descent from the root
 
-		while (current_node) {
+		const auto next = const_cast<red_black_node<t>*>(hint.node);
 
-			if (data == current_node->data) {
-				return true;
-			}
+		existing = nullptr;
 
-			if (data < current_node->data) {
-				current_node = current_node->left;
-			}
 
-			else {
-				current_node = current_node->right;
+		// Find the predecessor of hint, the largest node for end() //
+
+		red_black_node<t>* previous = nullptr;
+
+		if (!next) {
+			previous = tree.rightmost;
+		}
+
+		else if (next->left) {
+			previous = static_cast<red_black_node<t>*>(get_maximum_node<t>(next->left));
+		}
+
+		else {
+
+			const tree_node<t>* child = next;
+			previous = next->get_parent();
+
+			while (previous && child == previous->left) {
+
+				child = previous;
+				previous = previous->get_parent();
+
 			}
 
 		}
 
-		return false;
+
+		// Use the hint if data fits between the two, otherwise descend as usual //
+
+		if ((next && !tree.comparator(data, next->data)) ||
+			(previous && !tree.comparator(previous->data, data))) {
+			return find_insert_parent<t>(data, tree, is_left, existing);
+		}
+
+		// One of the two has a free slot facing the other
+		if (next && !next->left) {
+
+			is_left = true;
+			return next;
+
+		}
+
+		is_left = false;
+		return previous;
+
+	}
+
+	template <typename t, typename... options>
+	void refresh_rightmost(
+		red_black_tree<t, options...>& tree) {
+
+		// Looks the largest node up again after the tree was rebuilt or cut apart
+
+		tree.rightmost = tree.root ?
+			static_cast<red_black_node<t>*>(get_maximum_node<t>(tree.root)) :
+			nullptr;
+
+	}
+
+	template <typename t, typename... options>
+	void attach_node(
+		red_black_tree<t, options...>& tree,
+		red_black_node<t>* const parent,
+		const bool is_left,
+		red_black_node<t>* const new_node) {
+
+		++tree.element_count;
+
+
+		// If tree empty, the new node becomes the (black) root //
+
+		if (!parent) {
+			new_node->set_color(color::black);
+			tree.root = new_node;
+			tree.rightmost = new_node;
+			update_node<t>(tree, new_node);
+			return;
+		}
+
+		if (!is_left && parent == tree.rightmost) {
+			tree.rightmost = new_node;
+		}
+
+
+		// Add the new node to the leaf //
+
+		new_node->set_color(color::red);
+
+		if (is_left) {
+			parent->left = new_node;
+		}
+
+		else {
+			parent->right = new_node;
+		}
+
+		new_node->set_parent(parent);
+
+		update_path<t>(tree, new_node);
+
+
+		// Rebalance the tree if necessary //
+
+		fix_insert<t>(tree, new_node);
+
+	}
+
+	template <typename t, typename... options>
+	bool count_duplicate(
+		red_black_tree<t, options...>& tree,
+		red_black_node<t>* const existing) {
+
+		// Counts another payload equivalent to existing's on a multiset
+		// Returns false if the tree rejects duplicates
+
+		using node_type = typename red_black_tree<t, options...>::node_type;
+
+		if constexpr (std::is_base_of<multiplicity, node_type>::value) {
+
+			++static_cast<node_type*>(existing)->count;
+			++tree.element_count;
+
+			update_path<t>(tree, existing);
+
+			return true;
+
+		}
+
+		else {
+			return false;
+		}
+
+	}
+
+	template <typename t, typename... options, typename payload>
+	std::pair<red_black_node<t>*, bool> insert_node(
+		red_black_tree<t, options...>& tree,
+		red_black_node<t>* const parent,
+		const bool is_left,
+		red_black_node<t>* const existing,
+		payload&& data) {
+
+		// Links a new node holding data below parent, as found by find_insert_parent
+		// A duplicate is counted on a multiset and rejected otherwise, returning false along with its node
+
+		if (existing) {
+			return std::make_pair(existing, count_duplicate<t>(tree, existing));
+		}
+
+		const auto new_node = acquire_pool<t>(tree)->allocate(std::forward<payload>(data));
+
+		attach_node<t>(tree, parent, is_left, new_node);
+
+		return std::make_pair(static_cast<red_black_node<t>*>(new_node), true);
+
+	}
+
+	template <typename t, typename... options>
+	std::size_t destroy_subtree(
+		red_black_tree<t, options...>& tree,
+		red_black_node<t>* const node) {
+
+		// Returns the number of released nodes
+		// Left children are rotated up until the subtree degenerates into a list along the right links,
+		// so the teardown needs no memory besides the nodes themselves
+		/*
+				    c				  b
+				   / \				 / \
+				  b   d		->		a   c
+				 / \					   / \
+				a   x				  x   d
+		*/
+
+		std::size_t count = 0;
+
+		tree_node<t>* current_node = node;
+
+		while (current_node) {
+
+			const auto left = current_node->left;
+
+			if (left) {
+
+				current_node->left = left->right;
+				left->right = current_node;
+				current_node = left;
+
+			}
+
+			else {
+
+				const auto next = current_node->right;
+
+				release_node<t>(tree, static_cast<red_black_node<t>*>(current_node));
+				++count;
+
+				current_node = next;
+
+			}
+
+		}
+
+		return count;
+
+	}
+
+	template <typename t, typename... options, typename iterator>
+	red_black_node<t>* build_subtree(
+		red_black_tree<t, options...>& tree,
+		iterator& first,
+		const std::size_t count,
+		const std::size_t depth,
+		const std::size_t red_depth,
+		const red_black_node<t>*& previous) {
+
+		// Builds a balanced subtree from the next count payloads of a sorted range
+		// The payloads are consumed in order, so the range is only walked once
+
+		if (count == 0) return nullptr;
+
+		const auto left_count = (count - 1) / 2;
+
+
+		// Build the left subtree //
+
+		const auto left = build_subtree<t>(tree, first, left_count, depth + 1, red_depth, previous);
+
+
+		// Build the subtree's root //
+
+		red_black_node<t>* node = nullptr;
+
+		try {
+
+			node = acquire_pool<t>(tree)->allocate(*first);
+
+			if (previous && !tree.comparator(previous->data, node->data)) {
+				throw std::invalid_argument("Range is not sorted or contains duplicates");
+			}
+
+		}
+
+		catch (...) {
+
+			release_node<t>(tree, node);
+			destroy_subtree<t>(tree, left);
+
+			throw;
+
+		}
+
+		++first;
+		previous = node;
+
+		// Only the incomplete last level is red, so every path holds the same number of black nodes
+		node->set_color(depth == red_depth ? color::red : color::black);
+
+		node->left = left;
+
+		if (left) {
+			left->set_parent(node);
+		}
+
+
+		// Build the right subtree //
+
+		red_black_node<t>* right = nullptr;
+
+		try {
+			right = build_subtree<t>(tree, first, count - 1 - left_count, depth + 1, red_depth, previous);
+		}
+
+		catch (...) {
+
+			destroy_subtree<t>(tree, node);
+
+			throw;
+
+		}
+
+		node->right = right;
+
+		if (right) {
+			right->set_parent(node);
+		}
+
+		update_node<t>(tree, node);
+
+		return node;
+
+	}
+
+	template <typename t, typename... options>
+	red_black_node<t>* unlink_node(
+		red_black_tree<t, options...>& tree,
+		red_black_node<t>* const target_node) {
+
+		// Takes target_node out of the tree and returns it, releasing it is left to the caller
+		// Payloads never move between nodes, so every other node keeps holding its payload
+
+		// The largest node has no right child, so its predecessor is its left child or its parent
+		if (target_node == tree.rightmost) {
+			tree.rightmost = target_node->left ?
+				static_cast<red_black_node<t>*>(target_node->left) :
+				target_node->get_parent();
+		}
+
+		// Select a node to delete //
+
+		red_black_node<t>* to_be_deleted = nullptr;
+
+		// If the target node has at most 1 child
+		if (!target_node->left || !target_node->right) {
+
+			// Mark the target_node for deletion
+			to_be_deleted = target_node;
+
+		}
+
+		// If the target node has two children
+		else {
+
+			// Mark the left tree's max node for deletion
+			to_be_deleted = static_cast<red_black_node<t>*>(utils::get_maximum_node(target_node->left.get()));
+
+		}
+
+
+		// Get a handle to the child of the node to delete //
+
+		auto child = to_be_deleted->left ?
+			static_cast<red_black_node<t>*>(to_be_deleted->left) :
+			static_cast<red_black_node<t>*>(to_be_deleted->right);
+
+
+		// Connect the child to it's grandparent //
+
+		auto grandparent = to_be_deleted->get_parent();
+
+		// Set the child's parent to it's grandparent
+		if (child) {
+			child->set_parent(grandparent);
+		}
+
+		bool child_is_left = false;
+
+		// If the node to be deleted is the root node
+		if (!grandparent) {
+
+			// Let the child be the new root, roots are always black
+			tree.root = child;
+			set_color(child, color::black);
+
+		}
+
+		// If the node to be deleted is it's parent's left child
+		else if (to_be_deleted == grandparent->left) {
+
+			// Set the parent's left child to child
+			grandparent->left = child;
+			child_is_left = true;
+
+		}
+
+		// If the node to be deleted is it's parent's right child
+		else if(to_be_deleted == grandparent->right) {
+
+			// Set the parent's right child to child
+			grandparent->right = child;
+			child_is_left = false;
+
+		}
+
+
+		// The rebalancing depends on the color that left the spot of the node to delete
+		const auto removed_color = utils::get_color(to_be_deleted);
+
+
+		// Splice the predecessor into the target node's place //
+		/*
+				  *t				  *p
+				 /  \				 /  \
+				a    b		->		a    b
+				 \
+				  p
+		*/
+
+		if (to_be_deleted != target_node) {
+
+			const auto target_parent = target_node->get_parent();
+
+			to_be_deleted->left = target_node->left;
+			to_be_deleted->right = target_node->right;
+			to_be_deleted->set_parent(target_parent);
+			to_be_deleted->set_color(target_node->get_color());
+
+			if (to_be_deleted->left) {
+				static_cast<red_black_node<t>*>(to_be_deleted->left)->set_parent(to_be_deleted);
+			}
+
+			static_cast<red_black_node<t>*>(to_be_deleted->right)->set_parent(to_be_deleted);
+
+			if (!target_parent) {
+				tree.root = to_be_deleted;
+			}
+
+			else if (target_node == target_parent->left) {
+				target_parent->left = to_be_deleted;
+			}
+
+			else {
+				target_parent->right = to_be_deleted;
+			}
+
+			// The predecessor was the target node's left child, its child now hangs below it
+			if (grandparent == target_node) {
+				grandparent = to_be_deleted;
+			}
+
+		}
+
+
+		// Refresh the metadata of the nodes above the removed one //
+
+		update_path<t>(tree, grandparent);
+
+
+		// Rebalance //
+
+		if (removed_color == color::black && grandparent) {
+			utils::fix_delete<t>(tree, child, grandparent, child_is_left);
+		}
+
+
+		--tree.element_count;
+
+		target_node->left = nullptr;
+		target_node->right = nullptr;
+		target_node->set_parent(nullptr);
+
+		return target_node;
+
+	}
+
+	template <typename t, typename... options>
+	void remove_node(
+		red_black_tree<t, options...>& tree,
+		red_black_node<t>* const target_node) {
+
+		release_node<t>(tree, unlink_node<t>(tree, target_node));
+
+	}
+
+	template <typename t, typename... options>
+	void remove_one(
+		red_black_tree<t, options...>& tree,
+		red_black_node<t>* const node) {
+
+		// Counts a multiset node down, removing it along with its last payload
+
+		using node_type = typename red_black_tree<t, options...>::node_type;
+
+		if constexpr (std::is_base_of<multiplicity, node_type>::value) {
+
+			if (static_cast<node_type*>(node)->count > 1) {
+
+				--static_cast<node_type*>(node)->count;
+				--tree.element_count;
+
+				update_path<t>(tree, node);
+
+				return;
+
+			}
+
+		}
+
+		remove_node<t>(tree, node);
+
+	}
+
+	template <typename t, typename... options>
+	std::size_t payload_count(
+		const red_black_tree<t, options...>&,
+		const red_black_node<t>* const node) noexcept {
+
+		// Number of payloads a node stands for, more than one only on a multiset
+
+		using node_type = typename red_black_tree<t, options...>::node_type;
+
+		if constexpr (std::is_base_of<multiplicity, node_type>::value) {
+			return static_cast<const node_type*>(node)->count;
+		}
+
+		else {
+			return 1;
+		}
+
+	}
+
+	template <typename t, typename... options>
+	auto extract_node(
+		red_black_tree<t, options...>& tree,
+		red_black_node<t>* const target_node) {
+
+		// Unlinks target_node and hands it out along with every payload it stands for
+
+		using node_type = typename red_black_tree<t, options...>::node_type;
+		using node_handle_type = typename red_black_tree<t, options...>::node_handle_type;
+
+		if (!target_node) return node_handle_type();
+
+		// unlink_node only accounts for a single payload
+		tree.element_count -= payload_count<t>(tree, target_node) - 1;
+
+		return node_handle_type(tree.pool, static_cast<node_type*>(unlink_node<t>(tree, target_node)));
+
+	}
+
+	template <typename t>
+	std::size_t black_height(
+		tree_node<t>* node) {
+
+		// Every path holds the same number of black nodes, so the left spine is as good as any
+
+		std::size_t height = 0;
+
+		for (; node; node = node->left) {
+
+			if (get_color<t>(node) == color::black) {
+				++height;
+			}
+
+		}
+
+		return height;
+
+	}
+
+	template <typename t>
+	std::size_t detach_subtree(
+		red_black_node<t>* const node,
+		std::size_t height) {
+
+		// Cuts node loose from its parent so it may serve as a tree of its own
+		// A red root is recolored black, which adds one to the black height
+
+		if (!node) return height;
+
+		node->set_parent(nullptr);
+
+		if (node->get_color() == color::red) {
+
+			node->set_color(color::black);
+			++height;
+
+		}
+
+		return height;
+
+	}
+
+	template <typename t, typename... options>
+	std::size_t join_subtrees(
+		red_black_tree<t, options...>& tree,
+		red_black_node<t>* const left,
+		const std::size_t left_height,
+		red_black_node<t>* const pivot,
+		red_black_node<t>* const right,
+		const std::size_t right_height) {
+
+		// Links the detached trees left and right below pivot and stores the result in tree.root
+		// Both roots have to be black and every payload of left has to order before pivot, before all of right
+		// Runs in O(|left_height - right_height| + 1) and returns the black height of the result
+
+
+		// Equal heights, the pivot becomes the new root //
+		/*
+				  bp
+				 /  \
+				L    R
+		*/
+
+		if (left_height == right_height) {
+
+			pivot->left = left;
+			pivot->right = right;
+			pivot->set_parent(nullptr);
+			pivot->set_color(color::black);
+
+			if (left) left->set_parent(pivot);
+			if (right) right->set_parent(pivot);
+
+			tree.root = pivot;
+			update_node<t>(tree, pivot);
+
+			return left_height + 1;
+
+		}
+
+
+		// Descend the spine of the taller tree that faces the shorter one //
+		// until a black node of the shorter tree's height is reached
+
+		const auto left_taller = left_height > right_height;
+		const auto shorter_height = left_taller ? right_height : left_height;
+
+		red_black_node<t>* parent = nullptr;
+		red_black_node<t>* current = left_taller ? left : right;
+		auto height = left_taller ? left_height : right_height;
+
+		while (get_color<t>(current) == color::red || height != shorter_height) {
+
+			if (get_color<t>(current) == color::black) {
+				--height;
+			}
+
+			parent = current;
+			current = static_cast<red_black_node<t>*>(left_taller ? current->right : current->left);
+
+		}
+
+
+		// Put the pivot in that node's place, holding it and the shorter tree //
+		/*
+				  *p					  *p
+				    \					    \
+				    rk		(left taller)	    rk
+				   /  \					   /  \
+				  bc   R				  bc   R
+		*/
+
+		pivot->set_color(color::red);
+		pivot->set_parent(parent);
+
+		if (left_taller) {
+
+			pivot->left = current;
+			pivot->right = right;
+			parent->right = pivot;
+
+			if (right) right->set_parent(pivot);
+
+		}
+
+		else {
+
+			pivot->left = left;
+			pivot->right = current;
+			parent->left = pivot;
+
+			if (left) left->set_parent(pivot);
+
+		}
+
+		if (current) current->set_parent(pivot);
+
+		tree.root = left_taller ? left : right;
+
+		update_path<t>(tree, pivot);
+
+
+		// The pivot may now sit below a red parent, which insertion knows how to resolve //
+
+		return (left_taller ? left_height : right_height) + (fix_insert<t>(tree, pivot) ? 1 : 0);
+
+	}
+
+	template <typename t, typename... options, typename key_t>
+	red_black_node<t>* split_subtree(
+		const key_t& key,
+		red_black_node<t>* const root,
+		const std::size_t root_height,
+		red_black_tree<t, options...>& left,
+		std::size_t& left_height,
+		red_black_tree<t, options...>& right,
+		std::size_t& right_height) {
+
+		// Splits the detached tree root into left.root, holding the payloads ordered before key, and right.root,
+		// holding those ordered after it; the node equivalent to key is cut loose and returned, if any
+
+
+		// Record the search path along with the black height of every node on it //
+		// A red-black tree of 64 bit size never exceeds a height of 128
+
+		red_black_node<t>* path[128];
+		std::size_t heights[128];
+		std::size_t depth = 0;
+
+		red_black_node<t>* found = nullptr;
+		red_black_node<t>* left_root = nullptr;
+		red_black_node<t>* right_root = nullptr;
+
+		left_height = 0;
+		right_height = 0;
+
+		auto height = root_height;
+
+		for (auto node = root; node; ++depth) {
+
+			const auto child_height = height - (node->get_color() == color::black ? 1 : 0);
+
+			if (!left.comparator(node->data, key) && !left.comparator(key, node->data)) {
+
+				// Everything below the match already lies on the correct side
+				found = node;
+
+				left_root = static_cast<red_black_node<t>*>(node->left);
+				right_root = static_cast<red_black_node<t>*>(node->right);
+				left_height = detach_subtree<t>(left_root, child_height);
+				right_height = detach_subtree<t>(right_root, child_height);
+
+				found->left = nullptr;
+				found->right = nullptr;
+				found->set_parent(nullptr);
+
+				break;
+
+			}
+
+			path[depth] = node;
+			heights[depth] = height;
+			height = child_height;
+
+			node = static_cast<red_black_node<t>*>(left.comparator(node->data, key) ? node->right : node->left);
+
+		}
+
+
+		// Join the path bottom up, every node together with the subtree it keeps on the far side //
+		// The black heights grow along the way, so the joins add up to O(log n)
+
+		for (auto i = depth; i-- > 0;) {
+
+			const auto node = path[i];
+			const auto child_height = heights[i] - (node->get_color() == color::black ? 1 : 0);
+
+			if (left.comparator(node->data, key)) {
+
+				const auto subtree = static_cast<red_black_node<t>*>(node->left);
+				const auto subtree_height = detach_subtree<t>(subtree, child_height);
+
+				left_height = join_subtrees<t>(left, subtree, subtree_height, node, left_root, left_height);
+				left_root = left.root;
+
+			}
+
+			else {
+
+				const auto subtree = static_cast<red_black_node<t>*>(node->right);
+				const auto subtree_height = detach_subtree<t>(subtree, child_height);
+
+				right_height = join_subtrees<t>(right, right_root, right_height, node, subtree, subtree_height);
+				right_root = right.root;
+
+			}
+
+		}
+
+		left.root = left_root;
+		right.root = right_root;
+
+		return found;
+
+	}
+
+	template <typename t, typename... options>
+	red_black_node<t>* concatenate_subtrees(
+		red_black_tree<t, options...>& tree,
+		red_black_node<t>* const left,
+		const std::size_t left_height,
+		red_black_node<t>* const right,
+		const std::size_t right_height,
+		std::size_t& height) {
+
+		// Joins two detached trees without a pivot by cutting the minimum out of right to serve as one
+
+		if (!right) {
+
+			height = left_height;
+			return left;
+
+		}
+
+		if (!left) {
+
+			height = right_height;
+			return right;
+
+		}
+
+		red_black_tree<t, options...> empty_holder(nullptr, tree.comparator);
+		red_black_tree<t, options...> rest_holder(nullptr, tree.comparator);
+		std::size_t empty_height = 0;
+		std::size_t rest_height = 0;
+
+		const auto pivot = split_subtree<t>(get_minimum_node<t>(right)->data, right, right_height,
+			empty_holder, empty_height,
+			rest_holder, rest_height);
+
+		const auto rest = rest_holder.root;
+		rest_holder.root = nullptr;
+
+		height = join_subtrees<t>(tree, left, left_height, pivot, rest, rest_height);
+
+		return tree.root;
+
+	}
+
+	template <typename t, typename... options, typename key_t>
+	void split_tree(
+		const key_t& key,
+		red_black_tree<t, options...>& tree,
+		red_black_tree<t, options...>& right) {
+
+		using node_type = typename red_black_tree<t, options...>::node_type;
+
+		// The halves are counted in nodes
+		static_assert(!std::is_base_of<multiplicity, node_type>::value,
+			"split does not support multisets");
+
+		if (&tree == &right) {
+			throw std::invalid_argument("Split requires two distinct trees");
+		}
+
+		// Hand the nodes to the other tree //
+
+		destroy_subtree<t>(right, right.root);
+		right.root = nullptr;
+		right.pool = tree.pool;
+
+		const auto total = tree.element_count;
+		const auto root = tree.root;
+
+		std::size_t left_height = 0;
+		std::size_t right_height = 0;
+
+		const auto found = split_subtree<t>(key, root, black_height<t>(root), tree, left_height, right, right_height);
+
+		// The payload equivalent to the key goes to the right
+		if (found) {
+			join_subtrees<t>(right, nullptr, 0, found, right.root, right_height);
+		}
+
+
+		// Distribute the element count //
+
+		if constexpr (std::is_base_of<order_statistics, node_type>::value) {
+			tree.element_count = subtree_size<node_type>(tree.root);
+		}
+
+		else {
+
+			// Without subtree sizes only the smaller half is counted, walking both halves in lockstep
+			auto left_iterator = tree.begin();
+			auto right_iterator = right.begin();
+			std::size_t counted = 0;
+
+			while (left_iterator != tree.end() && right_iterator != right.end()) {
+
+				++left_iterator;
+				++right_iterator;
+				++counted;
+
+			}
+
+			tree.element_count = left_iterator == tree.end() ? counted : total - counted;
+
+		}
+
+		right.element_count = total - tree.element_count;
+
+		refresh_rightmost<t>(tree);
+		refresh_rightmost<t>(right);
+
+	}
+
+	enum class set_operation { union_of, intersection_of, difference_of };
+
+	// Subtrees of a smaller black height are processed on the calling thread, forking costs more than it saves
+	constexpr std::size_t parallel_min_height = 8;
+
+	inline std::size_t fork_depth() noexcept {
+
+		// Fork until there are about twice as many tasks as cores, to even out unbalanced halves
+
+		const auto cores = static_cast<std::size_t>(std::thread::hardware_concurrency());
+
+		std::size_t depth = 0;
+
+		while ((std::size_t(1) << depth) < 2 * cores) {
+			++depth;
+		}
+
+		return depth;
+
+	}
+
+	template <typename t, typename... options>
+	red_black_node<t>* clone_subtree(
+		red_black_tree<t, options...>& tree,
+		const red_black_node<t>* const node,
+		const std::size_t height,
+		const std::size_t parallel_depth) {
+
+		// Copies the subtree below node into tree's pool node for node, colors and metadata included,
+		// without comparing or rebalancing anything
+		// While the subtree is large enough the right half is copied on another thread; the pool is not
+		// synchronized, so that thread allocates from a private pool, merged into tree's pool once it is done
+
+		using tree_type = red_black_tree<t, options...>;
+		using node_type = typename tree_type::node_type;
+
+		if (!node) return nullptr;
+
+
+		// Copy the node //
+
+		const auto copy = acquire_pool<t>(tree)->allocate(node->data);
+
+		copy->set_color(node->get_color());
+
+		if constexpr (!std::is_same<typename tree_type::augment_type, no_augmentation>::value) {
+			static_cast<typename tree_type::augment_type&>(*copy) =
+				static_cast<const typename tree_type::augment_type&>(*static_cast<const node_type*>(node));
+		}
+
+
+		// Copy the subtrees, the right one on another thread while they are large enough //
+
+		const auto source_left = static_cast<const red_black_node<t>*>(node->left);
+		const auto source_right = static_cast<const red_black_node<t>*>(node->right);
+		const auto child_height = height - (node->get_color() == color::black ? 1 : 0);
+
+		red_black_node<t>* left = nullptr;
+		red_black_node<t>* right = nullptr;
+
+		try {
+
+			if (parallel_depth > 0 && child_height >= parallel_min_height) {
+
+				tree_type right_holder(std::make_shared<node_pool<node_type>>(), tree.comparator);
+
+				const auto clone_right = [&]() {
+					return clone_subtree<t>(right_holder, source_right, child_height, parallel_depth - 1);
+				};
+
+				// Without a thread to spare the right half is copied here after the left one
+				std::future<red_black_node<t>*> right_task;
+
+				try {
+					right_task = std::async(std::launch::async, clone_right);
+				}
+
+				catch (const std::system_error&) {}
+
+				try {
+					left = clone_subtree<t>(tree, source_left, child_height, parallel_depth - 1);
+				}
+
+				catch (...) {
+
+					// The task has to finish before its pool goes
+					try {
+						if (right_task.valid()) destroy_subtree<t>(right_holder, right_task.get());
+					}
+
+					catch (...) {}
+
+					throw;
+
+				}
+
+				try {
+					right = right_task.valid() ? right_task.get() : clone_right();
+				}
+
+				catch (...) {
+
+					destroy_subtree<t>(tree, left);
+
+					throw;
+
+				}
+
+				// The nodes of the right half now belong to tree's pool
+				node_pool<node_type>::merge(acquire_pool<t>(tree), right_holder.pool);
+
+			}
+
+			else {
+
+				left = clone_subtree<t>(tree, source_left, child_height, parallel_depth);
+
+				try {
+					right = clone_subtree<t>(tree, source_right, child_height, parallel_depth);
+				}
+
+				catch (...) {
+
+					destroy_subtree<t>(tree, left);
+
+					throw;
+
+				}
+
+			}
+
+		}
+
+		catch (...) {
+
+			release_node<t>(tree, copy);
+
+			throw;
+
+		}
+
+
+		// Link //
+
+		copy->left = left;
+		copy->right = right;
+
+		if (left) left->set_parent(copy);
+		if (right) right->set_parent(copy);
+
+		return copy;
+
+	}
+
+	template <typename t, typename... options>
+	void clone_tree(
+		const red_black_tree<t, options...>& source,
+		red_black_tree<t, options...>& tree) {
+
+		// Fills the empty tree with a copy of source in linear time
+
+		tree.root = clone_subtree<t>(tree, source.root, black_height<t>(source.root), fork_depth());
+		tree.element_count = source.element_count;
+
+		if (tree.root) {
+			tree.root->set_parent(nullptr);
+		}
+
+		refresh_rightmost<t>(tree);
+
+	}
+
+	template <set_operation operation, typename t, typename... options>
+	red_black_node<t>* combine_subtrees(
+		const red_black_tree<t, options...>& context,
+		red_black_node<t>* const a,
+		const std::size_t a_height,
+		red_black_node<t>* const b,
+		const std::size_t b_height,
+		std::size_t& height,
+		const std::size_t parallel_depth,
+		std::vector<red_black_node<t>*>& discarded) {
+
+		// Combines the detached trees a and b divide and conquer style: b is split around the root of a,
+		// the halves are combined recursively and joined back around that root, O(m log(n / m + 1)) in total
+		// Nodes dropped from the result are collected in discarded, the pool must only be touched by one thread
+
+		using tree_type = red_black_tree<t, options...>;
+
+
+		// One side is empty //
+
+		if (!a || !b) {
+
+			if constexpr (operation == set_operation::union_of) {
+
+				height = a ? a_height : b_height;
+				return a ? a : b;
+
+			}
+
+			else if constexpr (operation == set_operation::intersection_of) {
+
+				if (a) discarded.push_back(a);
+				if (b) discarded.push_back(b);
+
+				height = 0;
+				return nullptr;
+
+			}
+
+			else {
+
+				if (b) discarded.push_back(b);
+
+				height = a_height;
+				return a;
+
+			}
+
+		}
+
+
+		// Split b around the root of a //
+
+		tree_type left_holder(nullptr, context.comparator);
+		tree_type right_holder(nullptr, context.comparator);
+		std::size_t b_left_height = 0;
+		std::size_t b_right_height = 0;
+
+		const auto found = split_subtree<t>(a->data, b, b_height,
+			left_holder, b_left_height,
+			right_holder, b_right_height);
+
+		const auto b_left = left_holder.root;
+		const auto b_right = right_holder.root;
+
+		// Holders only link nodes, they must not release them
+		left_holder.root = nullptr;
+		right_holder.root = nullptr;
+
+
+		// Cut the root of a loose from its subtrees //
+
+		const auto pivot = a;
+		const auto a_child_height = a_height - (pivot->get_color() == color::black ? 1 : 0);
+
+		const auto a_left = static_cast<red_black_node<t>*>(pivot->left);
+		const auto a_right = static_cast<red_black_node<t>*>(pivot->right);
+		const auto a_left_height = detach_subtree<t>(a_left, a_child_height);
+		const auto a_right_height = detach_subtree<t>(a_right, a_child_height);
+
+		pivot->left = nullptr;
+		pivot->right = nullptr;
+
+
+		// Combine both halves, the right one on another thread while the trees are large enough //
+
+		red_black_node<t>* left = nullptr;
+		red_black_node<t>* right = nullptr;
+		std::size_t left_height = 0;
+		std::size_t right_height = 0;
+
+		if (parallel_depth > 0 && a_child_height >= parallel_min_height) {
+
+			std::vector<red_black_node<t>*> right_discarded;
+
+			const auto combine_right = [&]() {
+				return combine_subtrees<operation, t>(context, a_right, a_right_height, b_right, b_right_height,
+					right_height, parallel_depth - 1, right_discarded);
+			};
+
+			// Without a thread to spare the right half is combined here after the left one
+			std::future<red_black_node<t>*> right_task;
+
+			try {
+				right_task = std::async(std::launch::async, combine_right);
+			}
+
+			catch (const std::system_error&) {}
+
+			left = combine_subtrees<operation, t>(context, a_left, a_left_height, b_left, b_left_height,
+				left_height, parallel_depth - 1, discarded);
+
+			right = right_task.valid() ? right_task.get() : combine_right();
+
+			discarded.insert(discarded.end(), right_discarded.begin(), right_discarded.end());
+
+		}
+
+		else {
+
+			left = combine_subtrees<operation, t>(context, a_left, a_left_height, b_left, b_left_height,
+				left_height, parallel_depth, discarded);
+
+			right = combine_subtrees<operation, t>(context, a_right, a_right_height, b_right, b_right_height,
+				right_height, parallel_depth, discarded);
+
+		}
+
+
+		// Join the halves, around the root of a if it belongs to the result //
+
+		const auto keep = operation == set_operation::union_of ||
+			(operation == set_operation::intersection_of) == (found != nullptr);
+
+		// A payload found in both trees is kept once, the one of a
+		if (found) {
+			discarded.push_back(found);
+		}
+
+		tree_type holder(nullptr, context.comparator);
+
+		if (keep) {
+
+			height = join_subtrees<t>(holder, left, left_height, pivot, right, right_height);
+
+		}
+
+		else {
+
+			discarded.push_back(pivot);
+			holder.root = concatenate_subtrees<t>(holder, left, left_height, right, right_height, height);
+
+		}
+
+		const auto result = holder.root;
+		holder.root = nullptr;
+
+		return result;
+
+	}
+
+	template <set_operation operation, typename t, typename... options>
+	void combine_trees(
+		red_black_tree<t, options...>& a,
+		red_black_tree<t, options...>& b,
+		red_black_tree<t, options...>& result) {
+
+		using node_type = typename red_black_tree<t, options...>::node_type;
+
+		// Dropped payloads are counted in nodes
+		static_assert(!std::is_base_of<multiplicity, node_type>::value,
+			"set operations do not support multisets");
+
+
+		// A tree combined with itself stays as it is, or turns empty for the difference //
+
+		if (&a == &b) {
+
+			if (&result != &a) {
+
+				clear(result);
+				swap(result, a);
+
+			}
+
+			if constexpr (operation == set_operation::difference_of) {
+				clear(result);
+			}
+
+			return;
+
+		}
+
+
+		// Take both trees apart, their nodes are reused for the result //
+
+		// The merged pool goes to the result, the emptied trees get pools of their own once they need them
+		if (a.pool && b.pool) node_pool<node_type>::merge(a.pool, b.pool);
+
+		const auto pool = a.pool ? a.pool : b.pool;
+		const auto total = a.element_count + b.element_count;
+
+		const auto a_root = a.root;
+		const auto b_root = b.root;
+
+		a.root = nullptr;
+		a.element_count = 0;
+		a.pool = nullptr;
+		b.root = nullptr;
+		b.element_count = 0;
+		b.pool = nullptr;
+
+		destroy_subtree<t>(result, result.root);
+		result.root = nullptr;
+		result.element_count = 0;
+		result.pool = pool;
+
+		a.rightmost = nullptr;
+		b.rightmost = nullptr;
+
+
+		// Combine //
+
+		std::vector<red_black_node<t>*> discarded;
+		std::size_t height = 0;
+
+		result.root = combine_subtrees<operation, t>(result,
+			a_root, black_height<t>(a_root),
+			b_root, black_height<t>(b_root),
+			height, fork_depth(), discarded);
+
+
+		// Release the dropped nodes on this thread //
+
+		std::size_t released = 0;
+
+		for (const auto node : discarded) {
+			released += destroy_subtree<t>(result, node);
+		}
+
+		result.element_count = total - released;
+
+		refresh_rightmost<t>(result);
+
+	}
+
+	template <set_operation operation, typename t, typename... options>
+	red_black_tree<t, options...> combine_copies(
+		const red_black_tree<t, options...>& a,
+		const red_black_tree<t, options...>& b) {
+
+		// Combines copies of a and b, so that neither input is touched even if combining fails halfway
+
+		red_black_tree<t, options...> a_copy(a);
+
+		if (&a == &b) {
+
+			combine_trees<operation, t>(a_copy, a_copy, a_copy);
+			return a_copy;
+
+		}
+
+		red_black_tree<t, options...> b_copy(b);
+
+		combine_trees<operation, t>(a_copy, b_copy, a_copy);
+
+		return a_copy;
+
+	}
+}
+
+namespace {
+
+	template <typename t, typename compare, typename augment>
+	struct red_black_tree {
+
+		using compare_type = compare;
+		using augment_type = augment;
+		using node_type = std::conditional_t<std::is_same<augment, no_augmentation>::value,
+			red_black_node<t>,
+			augmented_node<t, augment>>;
+		using iterator = tree_iterator<t, red_black_node<t>, node_type>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using node_handle_type = node_handle<t, node_type>;
+
+		red_black_node<t>* root;
+
+		// The node holding the largest payload, nullptr while empty, so that appends skip the descent
+		red_black_node<t>* rightmost;
+
+		// Orders the payloads, an instance of std::less<t> unless specified otherwise
+		compare comparator;
+
+		// Owns the memory of every node in the tree, nullptr after a move until the tree needs memory again
+		// The pool is not synchronized: trees split off from one another keep sharing it and must only be
+		// used from one thread at a time, which shares_pool tells
+		std::shared_ptr<node_pool<node_type>> pool;
+
+		// Number of payloads in the tree
+		std::size_t element_count;
+
+		red_black_tree() :
+
+			root(nullptr),
+			rightmost(nullptr),
+			comparator(),
+			pool(std::make_shared<node_pool<node_type>>()),
+			element_count(0) {}
+
+		explicit red_black_tree(
+			const compare& comparator) :
+
+			root(nullptr),
+			rightmost(nullptr),
+			comparator(comparator),
+			pool(std::make_shared<node_pool<node_type>>()),
+			element_count(0) {}
+
+		// Constructs an empty tree allocating from an existing pool, shared with other trees
+		red_black_tree(
+			std::shared_ptr<node_pool<node_type>> pool,
+			const compare& comparator) :
+
+			root(nullptr),
+			rightmost(nullptr),
+			comparator(comparator),
+			pool(std::move(pool)),
+			element_count(0) {}
+
+		// Range constructor, the range must be sorted and is walked twice, so it takes forward iterators
+		template <typename forward_iterator>
+		red_black_tree(
+			const forward_iterator first,
+			const forward_iterator last,
+			const compare& comparator = compare()) :
+
+			root(nullptr),
+			rightmost(nullptr),
+			comparator(comparator),
+			pool(std::make_shared<node_pool<node_type>>()),
+			element_count(0) {
+
+			assign(first, last, *this);
+
+		}
+
+		// Copy constructor
+		// Clones the structure of other in linear time, large trees on several threads
+		red_black_tree(
+			const red_black_tree& other) :
+
+			root(nullptr),
+			rightmost(nullptr),
+			comparator(other.comparator),
+			pool(std::make_shared<node_pool<node_type>>()),
+			element_count(0) {
+
+			utils::clone_tree<t>(other, *this);
+
+		}
+
+		// Move constructor
+		// Takes the nodes and the pool of other over in constant time, other is left empty and gets a pool
+		// of its own once it needs memory again, so the two never share an unsynchronized pool
+		red_black_tree(
+			red_black_tree&& other) noexcept(std::is_nothrow_move_constructible<compare>::value) :
+
+			root(other.root),
+			rightmost(other.rightmost),
+			comparator(std::move(other.comparator)),
+			pool(std::move(other.pool)),
+			element_count(other.element_count) {
+
+			other.root = nullptr;
+			other.rightmost = nullptr;
+			other.element_count = 0;
+
+		}
+
+		// Destructor
+		~red_black_tree() {
+
+			if (!this->root) return;
+
+			// Trivial nodes are released in bulk together with the pool's chunks, unless other trees still use them
+			// Augmentations may add members of their own, so the whole node has to be trivial, not only the payload
+			if (std::is_trivially_destructible<node_type>::value &&
+				this->pool.use_count() == 1 &&
+				!this->pool->successor) return;
+
+			utils::destroy_subtree<t>(*this, this->root);
+
+		}
+
+		// Copy assignment
+		red_black_tree& operator=(
+			const red_black_tree& other) {
+
+			if (this == &other) return *this;
+
+			// The current content goes along with the copy
+			red_black_tree copy(other);
+			swap(*this, copy);
+
+			return *this;
+
+		}
+
+		// Move assignment
+		// Like the move constructor, other is left empty without a pool of its own until it needs one
+		red_black_tree& operator=(
+			red_black_tree&& other) noexcept(std::is_nothrow_move_assignable<compare>::value) {
+
+			if (this == &other) return *this;
+
+			clear(*this);
+
+			this->root = other.root;
+			this->rightmost = other.rightmost;
+			this->comparator = std::move(other.comparator);
+			this->pool = std::move(other.pool);
+			this->element_count = other.element_count;
+
+			other.root = nullptr;
+			other.rightmost = nullptr;
+			other.element_count = 0;
+
+			return *this;
+
+		}
+
+		iterator begin() const noexcept {
+
+			if (!this->root) return this->end();
+
+			return iterator(static_cast<const red_black_node<t>*>(utils::get_minimum_node<t>(this->root)), &this->root);
+
+		}
+
+		iterator end() const noexcept {
+
+			return iterator(nullptr, &this->root);
+
+		}
+
+		reverse_iterator rbegin() const noexcept {
+
+			return reverse_iterator(this->end());
+
+		}
+
+		reverse_iterator rend() const noexcept {
+
+			return reverse_iterator(this->begin());
+
+		}
+
+	};
+
+	template <typename t, typename... options>
+	void insert(
+		const t& data,
+		red_black_tree<t, options...>& tree) {
+
+		bool is_left = false;
+		red_black_node<t>* existing = nullptr;
+		const auto parent = utils::find_insert_parent<t>(data, tree, is_left, existing);
+
+		if (!utils::insert_node<t>(tree, parent, is_left, existing, data).second) {
+			throw std::runtime_error("Duplicate entry not supported");
+		}
+
+	}
+
+	template <typename t, typename... options>
+	void insert(
+		t&& data,
+		red_black_tree<t, options...>& tree) {
+
+		bool is_left = false;
+		red_black_node<t>* existing = nullptr;
+		const auto parent = utils::find_insert_parent<t>(data, tree, is_left, existing);
+
+		if (!utils::insert_node<t>(tree, parent, is_left, existing, std::move(data)).second) {
+			throw std::runtime_error("Duplicate entry not supported");
+		}
+
+	}
+
+	template <typename t, typename... options>
+	auto try_insert(
+		const t& data,
+		red_black_tree<t, options...>& tree) {
+
+		// Inserts data unless an equivalent payload is present, without throwing in that case
+		// Returns an iterator to the payload in the tree and whether data was inserted
+
+		bool is_left = false;
+		red_black_node<t>* existing = nullptr;
+		const auto parent = utils::find_insert_parent<t>(data, tree, is_left, existing);
+		const auto result = utils::insert_node<t>(tree, parent, is_left, existing, data);
+
+		return std::make_pair(typename red_black_tree<t, options...>::iterator(result.first, &tree.root), result.second);
+
+	}
+
+	template <typename t, typename... options>
+	auto try_insert(
+		t&& data,
+		red_black_tree<t, options...>& tree) {
+
+		bool is_left = false;
+		red_black_node<t>* existing = nullptr;
+		const auto parent = utils::find_insert_parent<t>(data, tree, is_left, existing);
+		const auto result = utils::insert_node<t>(tree, parent, is_left, existing, std::move(data));
+
+		return std::make_pair(typename red_black_tree<t, options...>::iterator(result.first, &tree.root), result.second);
+
+	}
+
+	template <typename t, typename... options>
+	auto insert(
+		const typename red_black_tree<t, options...>::iterator hint,
+		const t& data,
+		red_black_tree<t, options...>& tree) {
+
+		// Inserts data, starting the search right before hint instead of at the root
+		// A correct hint, like end() for ascending payloads or the previous result, makes the insert O(1)
+		// before rebalancing, apart from stepping to hint's in order predecessor
+		// A wrong one costs that step and up to two comparisons on top of the plain insert's O(log n) descent,
+		// which it falls back to
+		// Returns an iterator to the new payload
+
+		bool is_left = false;
+		red_black_node<t>* existing = nullptr;
+		const auto parent = utils::find_hinted_parent<t>(hint, data, tree, is_left, existing);
+		const auto result = utils::insert_node<t>(tree, parent, is_left, existing, data);
+
+		if (!result.second) {
+			throw std::runtime_error("Duplicate entry not supported");
+		}
+
+		return typename red_black_tree<t, options...>::iterator(result.first, &tree.root);
+
+	}
+
+	template <typename t, typename... options>
+	auto insert(
+		const typename red_black_tree<t, options...>::iterator hint,
+		t&& data,
+		red_black_tree<t, options...>& tree) {
+
+		bool is_left = false;
+		red_black_node<t>* existing = nullptr;
+		const auto parent = utils::find_hinted_parent<t>(hint, data, tree, is_left, existing);
+		const auto result = utils::insert_node<t>(tree, parent, is_left, existing, std::move(data));
+
+		if (!result.second) {
+			throw std::runtime_error("Duplicate entry not supported");
+		}
+
+		return typename red_black_tree<t, options...>::iterator(result.first, &tree.root);
+
+	}
+
+	template <typename t, typename... options, typename... args>
+	void emplace_into(
+		red_black_tree<t, options...>& tree,
+		args&&... arguments) {
+
+		// Unlike the other free functions the tree comes first, a parameter pack can only be deduced
+		// at the end of the parameter list, and the name says so at the call site
+
+
+		// Build the payload inside its node //
+
+		auto new_node = utils::acquire_pool<t>(tree)->allocate(std::in_place, std::forward<args>(arguments)...);
+
+
+		// Find a parent leaf node for the new node //
+
+		red_black_node<t>* parent = nullptr;
+		red_black_node<t>* existing = nullptr;
+		bool is_left = false;
+
+		try {
+			parent = utils::find_insert_parent<t>(new_node->data, tree, is_left, existing);
+		}
+
+		catch (...) {
+
+			tree.pool->deallocate(new_node);
+
+			throw;
+
+		}
+
+
+		// The payload turned out to be a duplicate //
+
+		if (existing) {
+
+			tree.pool->deallocate(new_node);
+
+			if (!utils::count_duplicate<t>(tree, existing)) {
+				throw std::runtime_error("Duplicate entry not supported");
+			}
+
+			return;
+
+		}
+
+
+		// Link the new node //
+
+		utils::attach_node<t>(tree, parent, is_left, new_node);
+
+	}
+
+	template <typename t, typename... options>
+	bool remove(
+		const t& data,
+		red_black_tree<t, options...>& tree) {
+
+		const auto target_node = utils::find_node<t>(data, tree);
+
+		if (!target_node) {
+			return false;
+		}
+
+		utils::remove_one<t>(tree, target_node);
+
+		return true;
+
+	}
+
+	template <typename t, typename... options, typename key_t,
+		typename = std::enable_if_t<utils::is_transparent<typename red_black_tree<t, options...>::compare_type>::value>>
+	bool remove(
+		const key_t& key,
+		red_black_tree<t, options...>& tree) {
+
+		const auto target_node = utils::find_node<t>(key, tree);
+
+		if (!target_node) {
+			return false;
+		}
+
+		utils::remove_one<t>(tree, target_node);
+
+		return true;
+
+	}
+
+	template <typename t, typename... options>
+	auto extract(
+		const t& data,
+		red_black_tree<t, options...>& tree) {
+
+		// Unlinks the node holding the payload equivalent to data and hands it out without releasing it
+		// The returned handle is empty if there is no such payload, on a multiset it carries every counted one
+
+		return utils::extract_node<t>(tree, utils::find_node<t>(data, tree));
+
+	}
+
+	template <typename t, typename... options, typename key_t,
+		typename = std::enable_if_t<utils::is_transparent<typename red_black_tree<t, options...>::compare_type>::value>>
+	auto extract(
+		const key_t& key,
+		red_black_tree<t, options...>& tree) {
+
+		return utils::extract_node<t>(tree, utils::find_node<t>(key, tree));
+
+	}
+
+	template <typename t, typename... options>
+	auto insert(
+		typename red_black_tree<t, options...>::node_handle_type&& handle,
+		red_black_tree<t, options...>& tree) {
+
+		// Links the node of an extracted handle back in, neither allocating nor copying its payload
+		// A node from another pool stays with it: its payload moves into a node of tree's own pool instead,
+		// so that trees used from different threads never end up sharing a pool
+		// A duplicate leaves the handle untouched and throws, a multiset takes over its counted payloads instead
+		// Returns an iterator to the payload, end() for an empty handle
+
+		using iterator = typename red_black_tree<t, options...>::iterator;
+		using node_type = typename red_black_tree<t, options...>::node_type;
+
+		if (handle.empty()) return tree.end();
+
+		bool is_left = false;
+		red_black_node<t>* existing = nullptr;
+		const auto parent = utils::find_insert_parent<t>(handle.value(), tree, is_left, existing);
+
+
+		// The payload turned out to be a duplicate //
+
+		if (existing) {
+
+			if constexpr (std::is_base_of<multiplicity, node_type>::value) {
+
+				const auto added = utils::payload_count<t>(tree, handle.node);
+
+				static_cast<node_type*>(existing)->count += added;
+				tree.element_count += added;
+
+				utils::update_path<t>(tree, existing);
+
+				handle.pool->deallocate(handle.release());
+
+				return iterator(existing, &tree.root);
+
+			}
+
+			else {
+				throw std::runtime_error("Duplicate entry not supported");
+			}
+
+		}
+
+
+		// Link the node, or a copy of it from tree's pool //
+
+		node_type* node = nullptr;
+
+		if (tree.pool && handle.pool->owner() == tree.pool->owner()) {
+			node = handle.release();
+		}
+
+		else {
+
+			node = utils::acquire_pool<t>(tree)->allocate(std::move(handle.value()));
+
+			if constexpr (std::is_base_of<multiplicity, node_type>::value) {
+				node->count = handle.node->count;
+			}
+
+			handle.pool->deallocate(handle.release());
+
+		}
+
+		utils::attach_node<t>(tree, parent, is_left, node);
+
+		tree.element_count += utils::payload_count<t>(tree, node) - 1;
+
+		return iterator(node, &tree.root);
+
+	}
+
+	template <typename t, typename... options>
+	bool find(
+		const t& data,
+		const red_black_tree<t, options...>& tree) {
+
+		return utils::find_node<t>(data, tree) != nullptr;
+
+	}
+
+	template <typename t, typename... options, typename key_t,
+		typename = std::enable_if_t<utils::is_transparent<typename red_black_tree<t, options...>::compare_type>::value>>
+	bool find(
+		const key_t& key,
+		const red_black_tree<t, options...>& tree) {
+
+		return utils::find_node<t>(key, tree) != nullptr;
+
+	}
+
+	template <typename t, typename... options>
+	void find_batch(
+		const std::vector<t>& keys,
+		std::vector<bool>& results,
+		const red_black_tree<t, options...>& tree) {
+
+		// Looks every key up, results[i] telling whether keys[i] was found
+		// The descents run interleaved in groups, so that a large tree out of cache keeps several
+		// misses in flight instead of waiting for each one in turn
+
+		results.assign(keys.size(), false);
+
+		for (std::size_t first = 0; first < keys.size(); first += utils::batch_group_size) {
+
+			const auto last = keys.size() - first < utils::batch_group_size ? keys.size() : first + utils::batch_group_size;
+
+			utils::find_group<t>(keys, first, last, results, tree);
+
+		}
+
+	}
+
+	template <typename t, typename... options, typename key_t,
+		typename = std::enable_if_t<utils::is_transparent<typename red_black_tree<t, options...>::compare_type>::value>>
+	void find_batch(
+		const std::vector<key_t>& keys,
+		std::vector<bool>& results,
+		const red_black_tree<t, options...>& tree) {
+
+		results.assign(keys.size(), false);
+
+		for (std::size_t first = 0; first < keys.size(); first += utils::batch_group_size) {
+
+			const auto last = keys.size() - first < utils::batch_group_size ? keys.size() : first + utils::batch_group_size;
+
+			utils::find_group<t>(keys, first, last, results, tree);
+
+		}
+
+	}
+
+	template <typename t, typename... options>
+	std::size_t count(
+		const t& data,
+		const red_black_tree<t, options...>& tree) {
+
+		// Number of payloads equivalent to data, at most one unless the tree is a multiset
+
+		const auto node = utils::find_node<t>(data, tree);
+
+		if (!node) return 0;
+
+		return utils::payload_count<t>(tree, node);
+
+	}
+
+	template <typename t, typename... options>
+	std::size_t size(
+		const red_black_tree<t, options...>& tree) noexcept {
+
+		return tree.element_count;
+
+	}
+
+	template <typename t, typename... options>
+	bool shares_pool(
+		const red_black_tree<t, options...>& a,
+		const red_black_tree<t, options...>& b) noexcept {
+
+		// Whether a and b allocate from the same memory, as the halves of a split do
+		// Such trees must not be changed from different threads at the same time
+
+		// A tree emptied by a move has no pool until it needs one again
+		return a.pool && b.pool && a.pool->owner() == b.pool->owner();
+
+	}
+
+	template <typename t, typename... options>
+	auto select(
+		std::size_t index,
+		const red_black_tree<t, options...>& tree) {
+
+		// Finds the payload with the given zero based position in order, end() if out of range
+		// Requires the order_statistics augmentation
+
+		using node_type = typename red_black_tree<t, options...>::node_type;
+
+		static_assert(std::is_base_of<order_statistics, node_type>::value,
+			"select requires a tree augmented with order_statistics");
+
+		const red_black_node<t>* current_node = tree.root;
+
+		while (current_node) {
+
+			const auto left_size = utils::subtree_size<node_type>(current_node->left.get());
+
+			if (index < left_size) {
+				current_node = static_cast<const red_black_node<t>*>(current_node->left);
+			}
+
+			else if (index > left_size) {
+				index -= left_size + 1;
+				current_node = static_cast<const red_black_node<t>*>(current_node->right);
+			}
+
+			else {
+				break;
+			}
+
+		}
+
+		return typename red_black_tree<t, options...>::iterator(current_node, &tree.root);
+
+	}
+
+	template <typename t, typename... options>
+	std::size_t rank(
+		const t& data,
+		const red_black_tree<t, options...>& tree) {
+
+		// Counts the payloads ordered before data
+		// Requires the order_statistics augmentation
+
+		using node_type = typename red_black_tree<t, options...>::node_type;
+
+		static_assert(std::is_base_of<order_statistics, node_type>::value,
+			"rank requires a tree augmented with order_statistics");
+
+		const tree_node<t>* current_node = tree.root;
+		std::size_t result = 0;
+
+		while (current_node) {
+
+			if (tree.comparator(current_node->data, data)) {
+				result += utils::subtree_size<node_type>(current_node->left.get()) + 1;
+				current_node = current_node->right;
+			}
+
+			else {
+				current_node = current_node->left;
+			}
+
+		}
+
+		return result;
+
+	}
+
+	template <typename t, typename... options, typename key_t>
+	auto aggregate_range(
+		const key_t& low,
+		const key_t& high,
+		const red_black_tree<t, options...>& tree) {
+
+		// Folds the payloads in [low, high) in order with the monoid of the tree's aggregate policy
+		// Only the two boundary paths are walked, whole subtrees contribute their stored aggregate
+
+		using node_type = typename red_black_tree<t, options...>::node_type;
+		using monoid = typename node_type::monoid_type;
+
+		const tree_node<t>* current_node = tree.root;
+
+
+		// Find the topmost node inside the range //
+
+		while (current_node) {
+
+			if (tree.comparator(current_node->data, low)) {
+				current_node = current_node->right;
+			}
+
+			else if (!tree.comparator(current_node->data, high)) {
+				current_node = current_node->left;
+			}
+
+			else {
+				break;
+			}
+
+		}
+
+		if (!current_node) {
+			return monoid::identity();
+		}
+
+
+		// Fold the part of its left subtree not ordered before low, right to left //
+
+		auto left_result = monoid::identity();
+
+		for (auto node = current_node->left; node;) {
+
+			if (!tree.comparator(node->data, low)) {
+
+				left_result = monoid::combine(
+					monoid::combine(node_type::lift_node(static_cast<const node_type&>(*node)),
+						utils::subtree_aggregate<node_type>(node->right.get())),
+					left_result);
+
+				node = node->left;
+
+			}
+
+			else {
+				node = node->right;
+			}
+
+		}
+
+
+		// Fold the part of its right subtree ordered before high, left to right //
+
+		auto right_result = monoid::identity();
+
+		for (auto node = current_node->right; node;) {
+
+			if (tree.comparator(node->data, high)) {
+
+				right_result = monoid::combine(
+					right_result,
+					monoid::combine(utils::subtree_aggregate<node_type>(node->left.get()),
+						node_type::lift_node(static_cast<const node_type&>(*node))));
+
+				node = node->right;
+
+			}
+
+			else {
+				node = node->left;
+			}
+
+		}
+
+		const auto& middle = static_cast<const node_type&>(*current_node);
+
+		return monoid::combine(monoid::combine(left_result, node_type::lift_node(middle)), right_result);
+
+	}
+
+	template <typename t, typename... options>
+	auto lower_bound(
+		const t& data,
+		const red_black_tree<t, options...>& tree) {
+
+		return typename red_black_tree<t, options...>::iterator(utils::lower_bound_node<t>(data, tree), &tree.root);
+
+	}
+
+	template <typename t, typename... options, typename key_t,
+		typename = std::enable_if_t<utils::is_transparent<typename red_black_tree<t, options...>::compare_type>::value>>
+	auto lower_bound(
+		const key_t& key,
+		const red_black_tree<t, options...>& tree) {
+
+		return typename red_black_tree<t, options...>::iterator(utils::lower_bound_node<t>(key, tree), &tree.root);
+
+	}
+
+	template <typename t, typename... options>
+	auto upper_bound(
+		const t& data,
+		const red_black_tree<t, options...>& tree) {
+
+		return typename red_black_tree<t, options...>::iterator(utils::upper_bound_node<t>(data, tree), &tree.root);
+
+	}
+
+	template <typename t, typename... options, typename key_t,
+		typename = std::enable_if_t<utils::is_transparent<typename red_black_tree<t, options...>::compare_type>::value>>
+	auto upper_bound(
+		const key_t& key,
+		const red_black_tree<t, options...>& tree) {
+
+		return typename red_black_tree<t, options...>::iterator(utils::upper_bound_node<t>(key, tree), &tree.root);
+
+	}
+
+	template <typename t, typename... options>
+	auto equal_range(
+		const t& data,
+		const red_black_tree<t, options...>& tree) {
+
+		return std::make_pair(lower_bound<t>(data, tree), upper_bound<t>(data, tree));
+
+	}
+
+	template <typename t, typename... options, typename key_t,
+		typename = std::enable_if_t<utils::is_transparent<typename red_black_tree<t, options...>::compare_type>::value>>
+	auto equal_range(
+		const key_t& key,
+		const red_black_tree<t, options...>& tree) {
+
+		return std::make_pair(lower_bound<t>(key, tree), upper_bound<t>(key, tree));
+
+	}
+
+	template <typename t, typename... options>
+	void swap(
+		red_black_tree<t, options...>& a,
+		red_black_tree<t, options...>& b) noexcept {
+
+		// Exchanges the contents in constant time, without touching a single node
+
+		std::swap(a.root, b.root);
+		std::swap(a.rightmost, b.rightmost);
+		std::swap(a.comparator, b.comparator);
+		std::swap(a.pool, b.pool);
+		std::swap(a.element_count, b.element_count);
+
+	}
+
+	template <typename t, typename... options>
+	void clear(
+		red_black_tree<t, options...>& tree) {
+
+		// Removes every payload, the nodes stay with the pool to be reused by the next insertions
+		// Trivial nodes of a tree that owns its pool alone are released all at once, without visiting them
+
+		using node_type = typename red_black_tree<t, options...>::node_type;
+
+		// Nothing to release, a tree emptied by a move may not even have a pool
+		if (!tree.root) return;
+
+		if (std::is_trivially_destructible<node_type>::value &&
+			tree.pool.use_count() == 1 &&
+			!tree.pool->successor) {
+			tree.pool->reset();
+		}
+
+		else {
+			utils::destroy_subtree<t>(tree, tree.root);
+		}
+
+		tree.root = nullptr;
+		tree.rightmost = nullptr;
+		tree.element_count = 0;
+
+	}
+
+	template <typename t, typename... options, typename forward_iterator>
+	void assign(
+		forward_iterator first,
+		const forward_iterator last,
+		red_black_tree<t, options...>& tree) {
+
+		// Builds the tree from a sorted range in linear time, without comparisons beyond
+		// the sortedness check and without rotations
+		// The range is measured before it is consumed, so single pass input iterators do not qualify
+
+		static_assert(std::is_base_of<std::forward_iterator_tag,
+			typename std::iterator_traits<forward_iterator>::iterator_category>::value,
+			"assign requires forward iterators, buffer an input range first");
+
+
+		// Release the current content, its nodes are reused for the new one //
+
+		clear(tree);
+
+
+		// Determine the depth of the first incomplete level //
+
+		const auto count = static_cast<std::size_t>(std::distance(first, last));
+
+		std::size_t red_depth = 0;
+
+		while ((std::size_t(2) << red_depth) - 1 <= count) {
+			++red_depth;
+		}
+
+
+		// Build //
+
+		const red_black_node<t>* previous = nullptr;
+
+		tree.root = utils::build_subtree<t>(tree, first, count, 0, red_depth, previous);
+		tree.element_count = count;
+
+		utils::refresh_rightmost<t>(tree);
+
+	}
+
+	template <typename t, typename... options>
+	void join(
+		red_black_tree<t, options...>& left,
+		t pivot,
+		red_black_tree<t, options...>& right) {
+
+		// Moves pivot and every payload of right into left in O(log n), right is left empty
+		// Every payload of left has to order before pivot, and pivot before every payload of right
+		// Right's memory goes to left along with its nodes, right gets a pool of its own once it needs one
+
+		using node_type = typename red_black_tree<t, options...>::node_type;
+
+		if ((left.root && !left.comparator(utils::get_maximum_node<t>(left.root)->data, pivot)) ||
+			(right.root && !left.comparator(pivot, utils::get_minimum_node<t>(right.root)->data))) {
+			throw std::invalid_argument("Join requires left < pivot < right");
+		}
+
+
+		// Nodes of both trees end up in one tree, so they have to share a pool //
+
+		const auto& pool = utils::acquire_pool<t>(left);
+
+		if (right.pool) node_pool<node_type>::merge(pool, right.pool);
+
+		const auto pivot_node = pool->allocate(std::move(pivot));
+
+
+		// Link //
+
+		const auto left_root = left.root;
+		const auto right_root = right.root;
+
+		utils::join_subtrees<t>(left,
+			left_root, utils::black_height<t>(left_root),
+			pivot_node,
+			right_root, utils::black_height<t>(right_root));
+
+		left.element_count += right.element_count + 1;
+
+		// The pivot orders after all of left
+		left.rightmost = right_root ? right.rightmost : pivot_node;
+
+		right.root = nullptr;
+		right.rightmost = nullptr;
+		right.element_count = 0;
+		right.pool = nullptr;
+
+	}
+
+	template <typename t, typename... options>
+	void split(
+		const t& data,
+		red_black_tree<t, options...>& tree,
+		red_black_tree<t, options...>& right) {
+
+		// Moves every payload not ordered before data from tree into right, dropping right's previous content
+		// Takes O(log n) with the order_statistics augmentation; without it the smaller half is counted to
+		// keep size() exact, adding O(min(|tree|, |right|))
+		// The halves keep sharing one unsynchronized pool (see shares_pool), so they must not be changed from
+		// different threads at the same time; copying a half gives it memory of its own
+		// tree and right have to be distinct trees
+
+		utils::split_tree<t>(data, tree, right);
+
+	}
+
+	template <typename t, typename... options, typename key_t,
+		typename = std::enable_if_t<utils::is_transparent<typename red_black_tree<t, options...>::compare_type>::value>>
+	void split(
+		const key_t& key,
+		red_black_tree<t, options...>& tree,
+		red_black_tree<t, options...>& right) {
+
+		utils::split_tree<t>(key, tree, right);
+
+	}
+
+	template <typename t, typename... options>
+	void set_union(
+		red_black_tree<t, options...>& a,
+		red_black_tree<t, options...>& b,
+		red_black_tree<t, options...>& result) {
+
+		// Builds the union of a and b in result, dropping result's previous content
+		// Consumes both inputs: their nodes are reused, so a and b are left empty, and if the comparator
+		// throws halfway their payloads are lost; the overload returning a new tree leaves them untouched
+		// result may be one of the inputs, and a and b may be the same tree
+		// Large trees are combined in parallel, with O(m log(n / m + 1)) work for sizes m <= n
+
+		utils::combine_trees<utils::set_operation::union_of, t>(a, b, result);
+
+	}
+
+	template <typename t, typename... options>
+	void set_intersection(
+		red_black_tree<t, options...>& a,
+		red_black_tree<t, options...>& b,
+		red_black_tree<t, options...>& result) {
+
+		// Builds the payloads of a also found in b in result, see set_union
+
+		utils::combine_trees<utils::set_operation::intersection_of, t>(a, b, result);
+
+	}
+
+	template <typename t, typename... options>
+	void set_difference(
+		red_black_tree<t, options...>& a,
+		red_black_tree<t, options...>& b,
+		red_black_tree<t, options...>& result) {
+
+		// Builds the payloads of a not found in b in result, see set_union
+
+		utils::combine_trees<utils::set_operation::difference_of, t>(a, b, result);
+
+	}
+
+	template <typename t, typename... options>
+	red_black_tree<t, options...> set_union(
+		const red_black_tree<t, options...>& a,
+		const red_black_tree<t, options...>& b) {
+
+		// Returns the union of a and b as a new tree, leaving both untouched
+		// Works on copies of the inputs, which adds O(n + m) to the consuming set_union
+
+		return utils::combine_copies<utils::set_operation::union_of, t>(a, b);
+
+	}
+
+	template <typename t, typename... options>
+	red_black_tree<t, options...> set_intersection(
+		const red_black_tree<t, options...>& a,
+		const red_black_tree<t, options...>& b) {
+
+		// Returns the payloads of a also found in b as a new tree, see set_union
+
+		return utils::combine_copies<utils::set_operation::intersection_of, t>(a, b);
+
+	}
+
+	template <typename t, typename... options>
+	red_black_tree<t, options...> set_difference(
+		const red_black_tree<t, options...>& a,
+		const red_black_tree<t, options...>& b) {
+
+		// Returns the payloads of a not found in b as a new tree, see set_union
+
+		return utils::combine_copies<utils::set_operation::difference_of, t>(a, b);
 
 	}
 
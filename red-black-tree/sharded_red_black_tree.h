@@ -0,0 +1,494 @@
+#pragma once
+
+#include "red_black_tree.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+	// Splits the key space into shards, each a red_black_tree with its own lock and pool,
+	// so that writers to different key ranges do not contend
+	//
+	//	  shard 0		 shard 1		 shard 2
+	//	[   ..., b0) [b0, ..., b1) [b1, ...   ]
+	//
+	template <typename t, typename compare = std::less<t>>
+	struct sharded_red_black_tree {
+
+		struct shard {
+
+			std::mutex lock;
+			red_black_tree<t, compare> tree;
+
+			explicit shard(
+				const compare& comparator) :
+
+				tree(comparator) {}
+
+		};
+
+		// Orders the payloads, an instance of std::less<t> unless specified otherwise
+		compare comparator;
+
+		std::vector<std::unique_ptr<shard>> shards;
+
+		// Shard i holds the payloads from boundaries[i - 1] up to boundaries[i], the outer shards are unbounded
+		// Until the first rebalance there are no boundaries and the first shard takes everything
+		std::vector<t> boundaries;
+
+		// Held shared by every operation and exclusively while the boundaries move
+		mutable std::shared_mutex layout;
+
+		// Number of payloads across all shards
+		std::atomic<std::size_t> element_count;
+
+		explicit sharded_red_black_tree(
+			const std::size_t shard_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1),
+			const compare& comparator = compare()) :
+
+			comparator(comparator),
+			element_count(0) {
+
+			for (std::size_t i = 0; i < std::max<std::size_t>(shard_count, 1); ++i) {
+				this->shards.push_back(std::make_unique<shard>(comparator));
+			}
+
+		}
+
+		// Copy constructor
+		sharded_red_black_tree(
+			const sharded_red_black_tree& other) = delete;
+
+		// Move constructor
+		sharded_red_black_tree(
+			sharded_red_black_tree&& other) = delete;
+
+		// Copy assignment
+		sharded_red_black_tree& operator=(
+			const sharded_red_black_tree& other) = delete;
+
+		// Move assignment
+		sharded_red_black_tree& operator=(
+			sharded_red_black_tree&& other) = delete;
+
+	};
+
+}
+
+namespace utils {
+
+	// Shards stay as they are while they hold fewer payloads than this
+	constexpr std::size_t min_rebalance_size = 1024;
+
+	template <typename t, typename compare, typename key_t>
+	std::size_t shard_index(
+		const key_t& key,
+		const sharded_red_black_tree<t, compare>& tree) {
+
+		// Counts the boundaries not ordered after key, the layout lock has to be held
+
+		const auto boundary = std::upper_bound(tree.boundaries.begin(), tree.boundaries.end(), key,
+			[&](const key_t& a, const t& b) { return tree.comparator(a, b); });
+
+		return static_cast<std::size_t>(boundary - tree.boundaries.begin());
+
+	}
+
+	template <typename t, typename compare>
+	bool is_skewed(
+		const std::size_t shard_size,
+		const sharded_red_black_tree<t, compare>& tree) {
+
+		// Whether a shard grew past twice the average of the other shards
+		// Its own size is left out of the average, otherwise a tree with few shards would hardly ever rebalance
+
+		const auto others = tree.shards.size() - 1;
+		const auto total = tree.element_count.load(std::memory_order_relaxed);
+		const auto rest = total > shard_size ? total - shard_size : 0;
+
+		return others > 0 &&
+			shard_size >= min_rebalance_size &&
+			shard_size * others > 2 * rest;
+
+	}
+
+	template <typename t, typename compare>
+	void redistribute(
+		sharded_red_black_tree<t, compare>& tree) {
+
+		// Rebuilds every shard with an equal share in linear time, the layout lock has to be held exclusively
+		// The shards are rebuilt from copies and only swapped in once all of them are built, so a payload
+		// that fails to copy leaves the tree as it was
+
+		std::vector<t> payloads;
+		payloads.reserve(tree.element_count.load(std::memory_order_relaxed));
+
+		for (auto& current_shard : tree.shards) {
+			payloads.insert(payloads.end(), current_shard->tree.begin(), current_shard->tree.end());
+		}
+
+		if (payloads.empty()) return;
+
+
+		// The first payload of every shard but the first becomes a boundary //
+
+		const auto shard_count = tree.shards.size();
+
+		std::vector<t> boundaries;
+		boundaries.reserve(shard_count - 1);
+
+		for (std::size_t i = 1; i < shard_count; ++i) {
+			boundaries.push_back(payloads[std::min(i * payloads.size() / shard_count, payloads.size() - 1)]);
+		}
+
+
+		// Rebuild //
+
+		std::vector<red_black_tree<t, compare>> rebuilt;
+		rebuilt.reserve(shard_count);
+
+		for (std::size_t i = 0; i < shard_count; ++i) {
+
+			const auto first = payloads.begin() + i * payloads.size() / shard_count;
+			const auto last = payloads.begin() + (i + 1) * payloads.size() / shard_count;
+
+			rebuilt.emplace_back(tree.comparator);
+
+			assign(std::make_move_iterator(first), std::make_move_iterator(last), rebuilt.back());
+
+		}
+
+
+		// Swap the new layout in //
+
+		for (std::size_t i = 0; i < shard_count; ++i) {
+			swap(tree.shards[i]->tree, rebuilt[i]);
+		}
+
+		tree.boundaries.swap(boundaries);
+
+	}
+
+	template <typename t, typename compare>
+	void migrate(
+		const std::size_t from,
+		const std::size_t to,
+		const std::size_t amount,
+		sharded_red_black_tree<t, compare>& tree) {
+
+		// Moves amount payloads across the boundary between the adjacent shards from and to, which have to
+		// hold fewer than from does; the layout lock has to be held exclusively
+		// The payloads are copied into to first and only dropped from from once the boundary moved, so a
+		// payload that fails to copy leaves both shards as they were
+
+		auto& source = tree.shards[from]->tree;
+		auto& target = tree.shards[to]->tree;
+
+		const auto upward = from < to;
+
+
+		// Find the payloads crossing the boundary, the last ones of source going up, the first ones going down //
+
+		auto first = source.begin();
+		auto last = source.end();
+
+		if (upward) {
+
+			first = last;
+
+			for (std::size_t i = 0; i < amount; ++i) {
+				--first;
+			}
+
+		}
+
+		else {
+
+			last = first;
+
+			for (std::size_t i = 0; i < amount; ++i) {
+				++last;
+			}
+
+		}
+
+		// The boundary becomes the lowest payload that ends up in the upper shard
+		t boundary = upward ? *first : *last;
+
+
+		// Copy the payloads over, next to the far end of target //
+
+		std::size_t copied = 0;
+
+		try {
+
+			if (upward) {
+
+				auto position = target.begin();
+
+				for (auto current = last; current != first;) {
+
+					--current;
+					position = insert(position, *current, target);
+					++copied;
+
+				}
+
+			}
+
+			else {
+
+				for (auto current = first; current != last; ++current) {
+
+					insert(target.end(), *current, target);
+					++copied;
+
+				}
+
+			}
+
+		}
+
+		catch (...) {
+
+			// Take the copies made so far back out
+			auto current = upward ? last : first;
+
+			for (std::size_t i = 0; i < copied; ++i) {
+
+				if (upward) --current;
+
+				remove<t>(*current, target);
+
+				if (!upward) ++current;
+
+			}
+
+			throw;
+
+		}
+
+		tree.boundaries[std::min(from, to)] = std::move(boundary);
+
+
+		// Drop the originals, cutting them off in one split //
+
+		red_black_tree<t, compare> moved(source.comparator);
+
+		split(tree.boundaries[std::min(from, to)], source, moved);
+
+		if (!upward) {
+			swap(source, moved);
+		}
+
+	}
+
+	template <typename t, typename compare>
+	void rebalance_shard(
+		const std::size_t index,
+		sharded_red_black_tree<t, compare>& tree) {
+
+		// Evens a skewed shard out with its lighter neighbour by moving the payloads next to their boundary,
+		// carrying on past that neighbour while it is skewed in turn; only the moved payloads are touched
+		// The layout lock has to be held exclusively
+
+		if (tree.boundaries.empty()) {
+
+			// Before the first rebalance every payload sits in the first shard anyway
+			redistribute<t>(tree);
+			return;
+
+		}
+
+		const auto shard_count = tree.shards.size();
+		const auto size_of = [&](const std::size_t i) { return size(tree.shards[i]->tree); };
+
+		const auto upward = index == 0 ||
+			(index + 1 < shard_count && size_of(index + 1) < size_of(index - 1));
+
+		for (auto from = index; upward ? from + 1 < shard_count : from > 0;) {
+
+			const auto to = upward ? from + 1 : from - 1;
+
+			if (size_of(from) <= size_of(to) + 1) break;
+
+			migrate<t>(from, to, (size_of(from) - size_of(to)) / 2, tree);
+
+			if (!is_skewed<t>(size_of(to), tree)) break;
+
+			from = to;
+
+		}
+
+	}
+
+}
+
+namespace {
+
+	template <typename t, typename compare>
+	void rebalance(
+		sharded_red_black_tree<t, compare>& tree) {
+
+		// Moves the boundaries so that every shard holds an equal share, blocking all other operations meanwhile
+
+		std::unique_lock<std::shared_mutex> layout_lock(tree.layout);
+
+		utils::redistribute<t>(tree);
+
+	}
+
+	template <typename t, typename compare>
+	void insert(
+		const t& data,
+		sharded_red_black_tree<t, compare>& tree) {
+
+		auto skewed = false;
+
+		{
+
+			std::shared_lock<std::shared_mutex> layout_lock(tree.layout);
+
+			auto& target = *tree.shards[utils::shard_index<t>(data, tree)];
+
+			std::lock_guard<std::mutex> shard_lock(target.lock);
+
+			insert<t>(data, target.tree);
+
+			++tree.element_count;
+
+			skewed = utils::is_skewed<t>(size(target.tree), tree);
+
+		}
+
+		// Another writer may have rebalanced in the meantime, so the skew is checked again
+		if (skewed) {
+
+			std::unique_lock<std::shared_mutex> layout_lock(tree.layout);
+
+			const auto index = utils::shard_index<t>(data, tree);
+
+			if (utils::is_skewed<t>(size(tree.shards[index]->tree), tree)) {
+				utils::rebalance_shard<t>(index, tree);
+			}
+
+		}
+
+	}
+
+	template <typename t, typename compare>
+	bool remove(
+		const t& data,
+		sharded_red_black_tree<t, compare>& tree) {
+
+		std::shared_lock<std::shared_mutex> layout_lock(tree.layout);
+
+		auto& target = *tree.shards[utils::shard_index<t>(data, tree)];
+
+		std::lock_guard<std::mutex> shard_lock(target.lock);
+
+		if (!remove<t>(data, target.tree)) {
+			return false;
+		}
+
+		--tree.element_count;
+
+		return true;
+
+	}
+
+	template <typename t, typename compare>
+	bool find(
+		const t& data,
+		const sharded_red_black_tree<t, compare>& tree) {
+
+		std::shared_lock<std::shared_mutex> layout_lock(tree.layout);
+
+		auto& target = *tree.shards[utils::shard_index<t>(data, tree)];
+
+		std::lock_guard<std::mutex> shard_lock(target.lock);
+
+		return find<t>(data, target.tree);
+
+	}
+
+	template <typename t, typename compare>
+	std::size_t size(
+		const sharded_red_black_tree<t, compare>& tree) noexcept {
+
+		return tree.element_count.load();
+
+	}
+
+	template <typename t, typename compare>
+	std::vector<t> collect_range(
+		const t& low,
+		const t& high,
+		const sharded_red_black_tree<t, compare>& tree) {
+
+		// Copies the payloads in [low, high) in order
+		// Every shard overlapping the range is scanned on its own thread, the shards being ordered
+		// by key their results only need to be concatenated
+
+		std::shared_lock<std::shared_mutex> layout_lock(tree.layout);
+
+		const auto first_shard = utils::shard_index<t>(low, tree);
+
+		const auto last_shard = static_cast<std::size_t>(std::lower_bound(tree.boundaries.begin(), tree.boundaries.end(), high,
+			[&](const t& a, const t& b) { return tree.comparator(a, b); }) - tree.boundaries.begin());
+
+		const auto scan = [&](const std::size_t index) {
+
+			auto& target = *tree.shards[index];
+
+			std::lock_guard<std::mutex> shard_lock(target.lock);
+
+			std::vector<t> result;
+
+			for (auto current = lower_bound<t>(low, target.tree);
+				current != target.tree.end() && tree.comparator(*current, high);
+				++current) {
+
+				result.push_back(*current);
+
+			}
+
+			return result;
+
+		};
+
+		if (last_shard <= first_shard) {
+			return scan(first_shard);
+		}
+
+		std::vector<std::future<std::vector<t>>> parts;
+
+		for (auto index = first_shard + 1; index <= last_shard; ++index) {
+			parts.push_back(std::async(std::launch::async, scan, index));
+		}
+
+		auto result = scan(first_shard);
+
+		for (auto& part : parts) {
+
+			const auto payloads = part.get();
+			result.insert(result.end(), payloads.begin(), payloads.end());
+
+		}
+
+		return result;
+
+	}
+
+}
\ No newline at end of file
@@ -3,116 +3,219 @@
 #include "red_black_tree.h"
 
 #include <functional>
+#include <type_traits>
+#include <vector>
 
 namespace {
 
+	// Type erased visitor, any callable taking a payload can be passed to the traversals instead
 	template <typename t>
 	using process = std::function<void(const t& data)>;
 
+	// Storage for level order traversals, can be kept around so repeated traversals don't allocate
 	template <typename t>
-	void traverse_in_order(
+	struct level_order_buffer {
+
+		std::vector<const tree_node<t>*> current_level;
+		std::vector<const tree_node<t>*> next_level;
+
+	};
+
+}
+
+namespace utils {
+
+	template <typename visitor, typename t>
+	bool visit(
+		visitor& process,
+		const t& data) {
+
+		// Visitors may return false to stop the traversal, visitors returning nothing never stop it
+
+		if constexpr (std::is_void<decltype(process(data))>::value) {
+
+			process(data);
+
+			return true;
+
+		}
+
+		else {
+
+			return static_cast<bool>(process(data));
+
+		}
+
+	}
+
+}
+
+namespace {
+
+	template <typename t, typename visitor>
+	bool traverse_in_order(
 		const tree_node<t>* const node,
-		const process<t> process) {
+		visitor&& process) {
 
-		if (!node) return;
+		if (!node) return true;
 
-		traverse_in_order<t>(node->left, process);
-		process(node->data);
-		traverse_in_order<t>(node->right, process);
+		return traverse_in_order<t>(node->left, process) &&
+			utils::visit(process, node->data) &&
+			traverse_in_order<t>(node->right, process);
 
 	}
 
-	template <typename t>
-	void traverse_in_order(
-		const red_black_tree<t>& tree,
-		const process<t> process) {
+	template <typename t, typename... options, typename visitor>
+	bool traverse_in_order(
+		const red_black_tree<t, options...>& tree,
+		visitor&& process) {
+
+		// Walk through parent pointers, no recursion needed
+		for (const auto& data : tree) {
 
-		traverse_in_order<t>(tree.root, process);
+			if (!utils::visit(process, data)) return false;
+
+		}
+
+		return true;
 
 	}
 
-	template <typename t>
-	void traverse_pre_order(
+	template <typename t, typename visitor>
+	bool traverse_pre_order(
 		const tree_node<t>* const node,
-		const process<t> process) {
+		visitor&& process) {
 
-		if (!node) return;
+		if (!node) return true;
 
-		process(node->data);
-		traverse_pre_order<t>(node->left, process);
-		traverse_pre_order<t>(node->right, process);
+		return utils::visit(process, node->data) &&
+			traverse_pre_order<t>(node->left, process) &&
+			traverse_pre_order<t>(node->right, process);
 
 	}
 
-	template <typename t>
-	void traverse_pre_order(
-		const red_black_tree<t>& tree,
-		const process<t> process) {
+	template <typename t, typename... options, typename visitor>
+	bool traverse_pre_order(
+		const red_black_tree<t, options...>& tree,
+		visitor&& process) {
 
-		traverse_pre_order<t>(tree.root, process);
+		return traverse_pre_order<t>(tree.root, process);
 
 	}
 
-	template <typename t>
-	void traverse_post_order(
+	template <typename t, typename visitor>
+	bool traverse_post_order(
 		const tree_node<t>* const node,
-		const process<t> process) {
+		visitor&& process) {
 
-		if (!node) return;
+		if (!node) return true;
 
-		traverse_post_order<t>(node->left, process);
-		traverse_post_order<t>(node->right, process);
-		process(node->data);
+		return traverse_post_order<t>(node->left, process) &&
+			traverse_post_order<t>(node->right, process) &&
+			utils::visit(process, node->data);
 
 	}
 
-	template <typename t>
-	void traverse_post_order(
-		const red_black_tree<t>& tree,
-		const process<t> process) {
+	template <typename t, typename... options, typename visitor>
+	bool traverse_post_order(
+		const red_black_tree<t, options...>& tree,
+		visitor&& process) {
 
-		traverse_post_order<t>(tree.root, process);
+		return traverse_post_order<t>(tree.root, process);
 
 	}
 
-	template <typename t>
-	void traverse_level_order(
-		tree_node<t>* node,
-		const process<t> process) {
+	template <typename t, typename visitor>
+	bool traverse_level_order(
+		const tree_node<t>* const node,
+		visitor&& process,
+		level_order_buffer<t>& buffer) {
 
-		if (!node) return;
+		if (!node) return true;
 
-		std::queue<tree_node<t>*> node_queue;
-		node_queue.push(node);
+		auto& current_level = buffer.current_level;
+		auto& next_level = buffer.next_level;
 
-		while (!node_queue.empty()) {
+		current_level.clear();
+		current_level.push_back(node);
 
-			// Dequeue
-			const auto current_node = node_queue.front();
-			node_queue.pop();
+		while (!current_level.empty()) {
 
-			// Process
-			process(current_node->data);
+			next_level.clear();
 
-			// Enqueue children
-			if (current_node->left) {
-				node_queue.push(current_node->left);
-			}
+			for (const auto current_node : current_level) {
+
+				// Process
+				if (!utils::visit(process, current_node->data)) return false;
+
+				// Enqueue children
+				if (current_node->left) {
+					next_level.push_back(current_node->left);
+				}
+
+				if (current_node->right) {
+					next_level.push_back(current_node->right);
+				}
 
-			if (current_node->right) {
-				node_queue.push(current_node->right);
 			}
 
+			// Proceed to the next level, keeping the capacity of both levels
+			current_level.swap(next_level);
+
 		}
 
+		return true;
+
 	}
 
-	template <typename t>
-	void traverse_level_order(
-		const red_black_tree<t>& tree,
-		const process<t> process) {
+	template <typename t, typename visitor>
+	bool traverse_level_order(
+		const tree_node<t>* const node,
+		visitor&& process) {
+
+		level_order_buffer<t> buffer;
+
+		return traverse_level_order<t>(node, process, buffer);
+
+	}
+
+	template <typename t, typename... options, typename visitor>
+	bool traverse_level_order(
+		const red_black_tree<t, options...>& tree,
+		visitor&& process,
+		level_order_buffer<t>& buffer) {
+
+		return traverse_level_order<t>(tree.root, process, buffer);
+
+	}
+
+	template <typename t, typename... options, typename visitor>
+	bool traverse_level_order(
+		const red_black_tree<t, options...>& tree,
+		visitor&& process) {
+
+		return traverse_level_order<t>(tree.root, process);
+
+	}
+
+	template <typename t, typename... options, typename key_t, typename visitor>
+	bool for_each_in_range(
+		const key_t& low,
+		const key_t& high,
+		const red_black_tree<t, options...>& tree,
+		visitor&& process) {
+
+		// Visits the payloads in [low, high) in order, in O(log n + k)
+
+		for (auto iterator = lower_bound<t>(low, tree); iterator != tree.end(); ++iterator) {
+
+			if (!tree.comparator(*iterator, high)) break;
+
+			if (!utils::visit(process, *iterator)) return false;
+
+		}
 
-		traverse_level_order<t>(tree.root, process);
+		return true;
 
 	}
 
@@ -0,0 +1,217 @@
+#pragma once
+
+#include "augmentation.h"
+#include "red_black_node.h"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace {
+
+	// Visits the payloads in order, counted_node_t being the tree's own node type: a multiset node is
+	// visited once for every payload it stands for
+	template <typename t, typename node_t = red_black_node<t>, typename counted_node_t = node_t>
+	struct tree_iterator {
+
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = t;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const t*;
+		using reference = const t&;
+
+		// The current node, nullptr past the last node
+		const node_t* node;
+
+		// The root slot of the iterated tree, needed to step back from the end
+		node_t* const* root;
+
+		// How many of the current node's payloads were stepped past, only ever non-zero on a multiset
+		std::size_t repeat;
+
+		tree_iterator() noexcept :
+
+			node(nullptr),
+			root(nullptr),
+			repeat(0) {}
+
+		tree_iterator(
+			const node_t* const node,
+			node_t* const* const root) noexcept :
+
+			node(node),
+			root(root),
+			repeat(0) {}
+
+		// Number of payloads the current node stands for
+		std::size_t copies() const noexcept {
+
+			if constexpr (std::is_base_of<multiplicity, counted_node_t>::value) {
+				return static_cast<const counted_node_t*>(this->node)->count;
+			}
+
+			else {
+				return 1;
+			}
+
+		}
+
+		reference operator*() const noexcept {
+
+			return this->node->data;
+
+		}
+
+		pointer operator->() const noexcept {
+
+			return &this->node->data;
+
+		}
+
+		// Pre increment, steps to the in order successor
+		tree_iterator& operator++() noexcept {
+
+			// Further payloads of a multiset node come first //
+
+			if (this->repeat + 1 < this->copies()) {
+
+				++this->repeat;
+				return *this;
+
+			}
+
+			this->repeat = 0;
+
+
+			// The successor is the leftmost node of the right subtree //
+
+			if (this->node->right) {
+
+				this->node = static_cast<const node_t*>(this->node->right);
+
+				while (this->node->left)
+					this->node = static_cast<const node_t*>(this->node->left);
+
+				return *this;
+
+			}
+
+
+			// Otherwise it's the first ancestor reached from a left subtree //
+
+			auto parent = this->node->get_parent();
+
+			while (parent && this->node == parent->right) {
+
+				this->node = parent;
+				parent = parent->get_parent();
+
+			}
+
+			this->node = parent;
+
+			return *this;
+
+		}
+
+		// Pre decrement, steps to the in order predecessor
+		tree_iterator& operator--() noexcept {
+
+			// Earlier payloads of a multiset node come first //
+
+			if (this->repeat > 0) {
+
+				--this->repeat;
+				return *this;
+
+			}
+
+
+			// Stepping back from the end reaches the maximum //
+
+			if (!this->node) {
+
+				this->node = *this->root;
+
+				while (this->node->right)
+					this->node = static_cast<const node_t*>(this->node->right);
+
+				this->repeat = this->copies() - 1;
+
+				return *this;
+
+			}
+
+
+			// The predecessor is the rightmost node of the left subtree //
+
+			if (this->node->left) {
+
+				this->node = static_cast<const node_t*>(this->node->left);
+
+				while (this->node->right)
+					this->node = static_cast<const node_t*>(this->node->right);
+
+				this->repeat = this->copies() - 1;
+
+				return *this;
+
+			}
+
+
+			// Otherwise it's the first ancestor reached from a right subtree //
+
+			auto parent = this->node->get_parent();
+
+			while (parent && this->node == parent->left) {
+
+				this->node = parent;
+				parent = parent->get_parent();
+
+			}
+
+			this->node = parent;
+
+			if (this->node) this->repeat = this->copies() - 1;
+
+			return *this;
+
+		}
+
+		// Post increment
+		tree_iterator operator++(int) noexcept {
+
+			auto previous = *this;
+			++*this;
+
+			return previous;
+
+		}
+
+		// Post decrement
+		tree_iterator operator--(int) noexcept {
+
+			auto previous = *this;
+			--*this;
+
+			return previous;
+
+		}
+
+		bool operator==(
+			const tree_iterator& other) const noexcept {
+
+			return this->node == other.node && this->repeat == other.repeat;
+
+		}
+
+		bool operator!=(
+			const tree_iterator& other) const noexcept {
+
+			return !(*this == other);
+
+		}
+
+	};
+
+}
\ No newline at end of file
@@ -1,27 +1,123 @@
 #pragma once
 
 #include <iostream> // temp
+#include <atomic>
+#include <type_traits>
+#include <utility>
 
 namespace {
 
+	// A child pointer that the readers of a concurrent_red_black_tree may follow while a writer changes it
+	// Plain reads are relaxed and stores release, which compiles to ordinary moves on common hardware;
+	// a speculative reader loads with acquire, so the payload of the node it reaches is fully built
+	template <typename node_t>
+	struct node_link {
+
+		std::atomic<node_t*> pointer;
+
+		node_link(
+			node_t* const pointer = nullptr) noexcept :
+
+			pointer(pointer) {}
+
+		// Copy constructor
+		node_link(
+			const node_link& other) noexcept :
+
+			pointer(other.get()) {}
+
+		// Copy assignment
+		node_link& operator=(
+			const node_link& other) noexcept {
+
+			this->pointer.store(other.get(), std::memory_order_release);
+
+			return *this;
+
+		}
+
+		node_link& operator=(
+			node_t* const pointer) noexcept {
+
+			this->pointer.store(pointer, std::memory_order_release);
+
+			return *this;
+
+		}
+
+		node_t* get() const noexcept {
+
+			return this->pointer.load(std::memory_order_relaxed);
+
+		}
+
+		node_t* acquire() const noexcept {
+
+			return this->pointer.load(std::memory_order_acquire);
+
+		}
+
+		operator node_t*() const noexcept {
+
+			return this->get();
+
+		}
+
+		// Lets the node types built on node_t be cast to directly, as with a raw pointer
+		template <typename derived_t,
+			typename = std::enable_if_t<std::is_base_of<node_t, std::remove_const_t<derived_t>>::value>>
+		explicit operator derived_t*() const noexcept {
+
+			return static_cast<derived_t*>(this->get());
+
+		}
+
+		node_t* operator->() const noexcept {
+
+			return this->get();
+
+		}
+
+	};
+
 	template <typename t>
 	struct tree_node {
 
 		t data;
-		tree_node<t>* left, * right;
+		node_link<tree_node<t>> left, right;
 
 		// Minimal constructor
 		tree_node(
-			const t data) noexcept :
+			const t& data) noexcept(std::is_nothrow_copy_constructible<t>::value) :
 
 			data(data),
 			left(nullptr),
 			right(nullptr) {
 		}
 
+		// Minimal constructor taking ownership of the payload
+		tree_node(
+			t&& data) noexcept(std::is_nothrow_move_constructible<t>::value) :
+
+			data(std::move(data)),
+			left(nullptr),
+			right(nullptr) {
+		}
+
+		// In place constructor, builds the payload from the given arguments
+		template <typename... args>
+		explicit tree_node(
+			std::in_place_t,
+			args&&... arguments) noexcept(std::is_nothrow_constructible<t, args...>::value) :
+
+			data(std::forward<args>(arguments)...),
+			left(nullptr),
+			right(nullptr) {
+		}
+
 		// Copy constructor
 		tree_node(
-			const tree_node& other) noexcept :
+			const tree_node& other) noexcept(std::is_nothrow_copy_constructible<t>::value) :
 
 			data(other.data),
 			left(other.left),
@@ -29,9 +125,9 @@ namespace {
 
 		// Move constructor
 		tree_node(
-			tree_node&& other) noexcept :
+			tree_node&& other) noexcept(std::is_nothrow_move_constructible<t>::value) :
 
-			data(other.data),
+			data(std::move(other.data)),
 			left(other.left),
 			right(other.right) {
 
@@ -41,11 +137,12 @@ namespace {
 		}
 
 		// Destructor
-		virtual ~tree_node() noexcept {}
+		// Non-virtual, nodes are only ever destroyed through their most derived type
+		~tree_node() = default;
 
 		// Copy assignment
 		tree_node& operator=(
-			const tree_node& other) noexcept {
+			const tree_node& other) noexcept(std::is_nothrow_copy_assignable<t>::value) {
 
 			if (this == &other) return *this;
 
@@ -59,11 +156,11 @@ namespace {
 
 		// Move assignment
 		tree_node& operator=(
-			tree_node&& other) noexcept {
+			tree_node&& other) noexcept(std::is_nothrow_move_assignable<t>::value) {
 
 			if (this == &other) return *this;
 
-			this->data = other.data;
+			this->data = std::move(other.data);
 			this->left = other.left;
 			this->right = other.right;
 